@@ -2,6 +2,7 @@
 #include "AnalysisBoard.h"
 #include "Game/Game.h"
 #include "Utilities/Utilities.h"
+#include "Core/Notation.h"
 
 AnalysisBoard::AnalysisBoard(const Rectangle& bounds, Game* owner)
 	: IBoard(bounds, owner), m_BestMoveArrow({}), m_FrameCounter(0), m_EvalBar_Bounds({}), m_Movelist_Bounds({}), m_MovelistContent_Bounds({}), m_Movelist_Scroll({}), m_UpdateScrollbar(false), m_BestLines_Bounds({}), m_BestLines_UITexts({})
@@ -34,10 +35,10 @@ void AnalysisBoard::Update()
 	std::lock_guard<std::mutex> lock(GameData::EngineMutex);
 	if (GameData::CurrentEngine->GetAnalysisData().BestLines.size() > 0 && GameData::CurrentEngine->GetAnalysisData().BestLines[0].size() > 0)
 	{
-		std::string bestMove = GameData::CurrentEngine->GetAnalysisData().BestLines[0][0];
-		Vector2 fromSquare = _ToRealSquare(bestMove.substr(0, 2));
+		Chess::Move bestMove = GameData::CurrentEngine->GetAnalysisData().BestLines[0][0];
+		Vector2 fromSquare = _ToRealSquare(bestMove.GetFrom());
 		Vector2 fromPosition = Vector2{ (fromSquare.x + 0.5f) * m_SquareSize + m_BoardBounds.x, (fromSquare.y + 0.5f) * m_SquareSize + m_BoardBounds.y };
-		Vector2 toSquare = _ToRealSquare(bestMove.substr(2, 2));
+		Vector2 toSquare = _ToRealSquare(bestMove.GetTo());
 		Vector2 toPosition = Vector2{ (toSquare.x + 0.5f) * m_SquareSize + m_BoardBounds.x, (toSquare.y + 0.5f) * m_SquareSize + m_BoardBounds.y };
 		m_BestMoveArrow = Arrow(fromPosition, toPosition, fromSquare, toSquare, Color{ 0, 143, 21, (unsigned char)(GameData::ArrowOpacity * 255) }, m_Flipped);
 	}
@@ -101,6 +102,7 @@ void AnalysisBoard::UpdateBounds()
 	m_SelectionFrom.UpdatePosition(m_BoardBounds, m_SquareSize);
 	m_LastMoveFrom.UpdatePosition(m_BoardBounds, m_SquareSize);
 	m_LastMoveTo.UpdatePosition(m_BoardBounds, m_SquareSize);
+	m_CheckHighlight.UpdatePosition(m_BoardBounds, m_SquareSize);
 
 	//Update pieces
 	Piece::Size = PIECE_SIZE_P * (float)m_SquareSize;
@@ -132,6 +134,7 @@ void AnalysisBoard::Draw() const
 
 	//Temporary texts
 	DrawTextEx(GameData::MainFont, std::to_string(GameData::CurrentEngine->GetAnalysisData().Depth).c_str(), Vector2{ 10, 10 }, 30, 0, RAYWHITE);
+	DrawTextEx(GameData::MainFont, (std::to_string(GameData::CurrentEngine->GetAnalysisData().Hashfull / 10) + "%").c_str(), Vector2{ 10, 40 }, 30, 0, RAYWHITE);
 }
 
 void AnalysisBoard::Reset(bool resetEnginePosition)
@@ -140,10 +143,10 @@ void AnalysisBoard::Reset(bool resetEnginePosition)
 	m_BestLines_UITexts.clear();
 }
 
-bool AnalysisBoard::_Move(const Vector2& fromSquare, const Vector2& toSquare, bool animated, bool updateEnginePosition)
+bool AnalysisBoard::_Move(const Vector2& fromSquare, const Vector2& toSquare, bool animated, bool updateEnginePosition, Chess::Kind promotion)
 {
 	m_UpdateScrollbar = true;
-	return IBoard::_Move(fromSquare, toSquare, animated, updateEnginePosition);
+	return IBoard::_Move(fromSquare, toSquare, animated, updateEnginePosition, promotion);
 }
 
 void AnalysisBoard::EvalBar_Draw() const
@@ -260,38 +263,37 @@ void AnalysisBoard::BestLines_Update()
 		m_FrameCounter = 0;
 		analysisData.BestLinesSN.resize(analysisData.BestLines.size());
 
-		//Backup
-		Piece backup[8][8];
-		memcpy(backup, m_Board, sizeof(m_Board));
-		Piece* whiteKingBackup = m_WhiteKing;
-		Piece* blackKingBackup = m_BlackKing;
-		bool whiteInCheckBackup = m_WhiteInCheck;
-		bool blackInCheckBackup = m_BlackInCheck;
-		int8_t sideToMoveBackup = m_SideToMove;
-
+		//Walk the lines on the position and take the moves back afterwards
+		std::vector<Chess::Move> line;
+		std::vector<Chess::UndoInfo> undos;
 		for (int i = 0; i < analysisData.BestLinesSN.size(); i++)
 		{
 			analysisData.BestLinesSN[i].resize(analysisData.BestLines[i].size());
+			bool valid = true;
 			for (int j = 0; j < analysisData.BestLinesSN[i].size(); j++)
 			{
-				if (analysisData.BestLines[i][j] == "")
+				const Chess::Move& move = analysisData.BestLines[i][j];
+				Chess::MoveList legalMoves;
+				m_Position.GenerateMoves<Chess::LEGAL>(legalMoves, Chess::SquareBB(move.GetFrom()));
+				valid = valid && legalMoves.Contains(move);
+				if (!valid)
 					analysisData.BestLinesSN[i][j] = "";
 				else
 				{
-					bool capture;
-					_TestMove(analysisData.BestLines[i][j], &capture);
-					_DoMove(analysisData.BestLines[i][j], false, false);
-					analysisData.BestLinesSN[i][j] = _GetShortNotation(analysisData.BestLines[i][j], capture);
+					analysisData.BestLinesSN[i][j] = Chess::ToSAN(m_Position, move);
+					line.push_back(move);
+					undos.emplace_back();
+					m_Position.MakeMove(move, undos.back());
 				}
 			}
-			
+
 			//Restore
-			memcpy(m_Board, backup, sizeof(backup));
-			m_WhiteKing = whiteKingBackup;
-			m_BlackKing = blackKingBackup;
-			m_WhiteInCheck = whiteInCheckBackup;
-			m_BlackInCheck = blackInCheckBackup;
-			m_SideToMove = sideToMoveBackup;
+			while (!line.empty())
+			{
+				m_Position.UnmakeMove(line.back(), undos.back());
+				line.pop_back();
+				undos.pop_back();
+			}
 		}
 	}
 
@@ -37,7 +37,7 @@ public:
 	void Reset(bool resetEnginePosition = true) override;
 
 protected:
-	bool _Move(const Vector2& fromSquare, const Vector2& toSquare, bool animated = false, bool updateEnginePosition = true) override;
+	bool _Move(const Vector2& fromSquare, const Vector2& toSquare, bool animated = false, bool updateEnginePosition = true, Chess::Kind promotion = Chess::QUEEN) override;
 
 private:
 	//UI functions
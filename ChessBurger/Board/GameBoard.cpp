@@ -20,7 +20,7 @@ void GameBoard::Update()
 	if (m_Moves.size() > 0)
 	{
 		//White moves, check clock time
-		if (m_SideToMove == 0)
+		if (m_Position.GetSideToMove() == Chess::WHITE_SIDE)
 		{
 			if (m_WhiteClock.GetSecondsLeft() <= 0)
 			{
@@ -34,7 +34,7 @@ void GameBoard::Update()
 			}
 		}
 		//Black moves, check clock time
-		else if (m_SideToMove == 1)
+		else if (m_Position.GetSideToMove() == Chess::BLACK_SIDE)
 		{
 			if (m_BlackClock.GetSecondsLeft() <= 0)
 			{
@@ -48,14 +48,18 @@ void GameBoard::Update()
 			}
 		}
 		//Computer should move
-		if (m_SideToMove == m_ComputerSide)
+		if (m_Position.GetSideToMove() == m_ComputerSide)
 		{
-			std::string& bestMove = GameData::CurrentEngine->GetBestMove();
-			if (bestMove != "")
+			//The engine publishes the move under the engine mutex, it is taken before moving as that talks to the engine
+			Chess::Move bestMove = Chess::Move::None();
+			{
+				std::lock_guard<std::mutex> lock(GameData::EngineMutex);
+				std::swap(bestMove, GameData::CurrentEngine->GetBestMove());
+			}
+			if (bestMove != Chess::Move::None())
 			{
 				if (!IBoard::_Move(bestMove, true))
 					std::invalid_argument("Computer made an illegal move");
-				bestMove = "";
 			}
 		}
 		//Update clocks
@@ -89,15 +93,15 @@ void GameBoard::Draw() const
 	DrawTextEx(GameData::MainFont, clockString.c_str(), Vector2{ m_BlackClockBounds.x + m_BlackClockBounds.width - width - 10, m_BlackClockBounds.y + (m_BlackClockBounds.height - CLOCK_TEXT_SIZE_A) * 0.5f }, CLOCK_TEXT_SIZE_A, 0, GameData::Colors.BgFocused);
 	
 	//Make clock look disabled
-	if (m_SideToMove == 0)
+	if (m_Position.GetSideToMove() == Chess::WHITE_SIDE)
 		DrawRectangleRounded(m_BlackClockBounds, 0.2f, 4, Fade(BLACK, 0.5f));
 	else
 		DrawRectangleRounded(m_WhiteClockBounds, 0.2f, 4, Fade(BLACK, 0.5f));
 }
 
-bool GameBoard::_Move(const Vector2& fromSquare, const Vector2& toSquare, bool animated, bool updateEnginePosition)
+bool GameBoard::_Move(const Vector2& fromSquare, const Vector2& toSquare, bool animated, bool updateEnginePosition, Chess::Kind promotion)
 {
-	if (IBoard::_Move(fromSquare, toSquare, animated))
+	if (IBoard::_Move(fromSquare, toSquare, animated, true, promotion))
 	{
 		GameData::CurrentEngine->SearchMove(m_WhiteClock.GetSecondsLeft() * 1000, m_BlackClock.GetSecondsLeft() * 1000, 0, 0);
 		return true;
@@ -5,6 +5,7 @@
 #include "Guides/Highlight.h"
 #include "Guides/Arrow.h"
 #include "Guides/Spot.h"
+#include "Core/Position.h"
 #include <memory>
 #include <string>
 #include <vector>
@@ -36,29 +37,32 @@ public:
 
 	virtual void Reset(bool resetEnginePosition = true);
 	bool LoadFEN(const std::string& fen);
+	const Chess::Position& GetPosition() const;
+	void SetPosition(const Chess::Position& position);
 	bool LoadPGN(std::string& pgn); //ONLY WITH 1 LINE!!!
 	void Flip();
 	void Clear();
 
 protected:
-	virtual bool _Move(const Vector2& fromSquare, const Vector2& toSquare, bool animated = false, bool updateEnginePosition = true);
+	virtual bool _Move(const Vector2& fromSquare, const Vector2& toSquare, bool animated = false, bool updateEnginePosition = true, Chess::Kind promotion = Chess::QUEEN);
 	bool _Move(const std::string& move, bool animated = false, bool updateEnginePosition = true);
-	void _DoMove(const Vector2& fromSquare, const Vector2& toSquare, bool registerMove = true, bool animated = false, bool playSound = true);
-	void _DoMove(const std::string& move, bool registerMove = true, bool animated = false, bool playSound = true);
-	bool _TestMove(const Vector2& fromSquare, const Vector2& toSquare, bool* capture = nullptr);
-	bool _TestMove(const std::string& move, bool* capture = nullptr);
-	void _CastleKing(Piece* king, int8_t direction, bool registerMove = true, bool animated = false, bool playSound = true);
-	bool _TestCastle(Piece* king, int8_t direction);
-	void _GetLegalMoves(uint8_t side);
-	bool _IsAttacked(Piece* piece);
-	bool _IsOnBoard(const Vector2& square);
-	void _RegisterMove(Piece* piece, const std::string& move, bool capture = false, bool halfMove = false);
+	bool _Move(const Chess::Move& move, bool animated = false, bool updateEnginePosition = true);
+	bool _PlayerMove(const Vector2& fromSquare, const Vector2& toSquare, bool animated = false);
+	void _DoMove(const Vector2& fromSquare, const Vector2& toSquare, bool registerMove = true, bool animated = false, bool playSound = true, Chess::Kind promotion = Chess::QUEEN);
+	void _DoMove(const Chess::Move& move, bool registerMove = true, bool animated = false, bool playSound = true);
+	void _CheckLegalMoves();
+	bool _FindMove(const Vector2& fromSquare, const Vector2& toSquare, Chess::Move& move, Chess::Kind promotion = Chess::QUEEN) const;
+	void _UpdatePromotion();
+	Rectangle _GetPromotionBounds(int index) const;
+	void _MovePiece(const Vector2& fromSquare, const Vector2& toSquare, bool animated);
+	void _SyncPieces();
+	bool _IsOnBoard(const Vector2& square) const;
+	void _RegisterMove(const Chess::Move& move);
 	void _ReloadBoard(bool lastMoveVisible);
-	std::string _ToChessNote(const Vector2& square) const;
-	std::string _GetShortNotation(const std::string& move, bool capture);
-	std::string _GetLongNotation(std::string& move);
 	Vector2 _ToSquare(const std::string& move) const;
 	Vector2 _ToRealSquare(const std::string& move) const;
+	Vector2 _ToRealSquare(Chess::Square square) const;
+	Chess::Square _ToCoreSquare(const Vector2& square) const;
 	Vector2 _GetSquare(const Vector2& position) const;
 	Vector2 _GetRealSquare(const Vector2& position) const;
 	std::string _MovesToString() const;
@@ -66,27 +70,30 @@ protected:
 	virtual std::string _GetPGN() const;
 
 protected:
+	Chess::Position m_Position;
 	Piece m_Board[8][8];
-	std::vector<std::string> m_Moves;
+	std::vector<Chess::Move> m_Moves;
 	std::vector<std::string> m_MovesSN;
-	std::vector<std::string> m_LegalMoves;
+	std::vector<Chess::Position> m_Positions;
+	std::vector<uint64_t> m_KeyHistory;
+	bool m_HasLegalMove;
 	std::vector<Spot> m_SelectedMoves;
 	std::string m_StartingFEN;
-	uint32_t m_HalfMoveClock;
 	int8_t m_Side;
 	bool m_AnalyseMode;
-	int8_t m_SideToMove;
 	Result m_Result;
 	std::string m_WhiteName;
 	std::string m_BlackName;
-	std::string m_EnPassant;
-	int32_t m_StartingFEN_Movecount;
 	int32_t m_MoveIndex;
 	std::vector<Highlight> m_Highlights;
 	std::vector<Arrow> m_Arrows;
 	Highlight m_SelectionFrom;
 	Highlight m_LastMoveFrom;
 	Highlight m_LastMoveTo;
+	Highlight m_CheckHighlight;
+	bool m_Promoting;
+	Vector2 m_PromotionFrom;
+	Vector2 m_PromotionTo;
 	Vector2 m_LeftDragStart;
 	Vector2 m_RightDragStart;
 	Vector2 m_MouseDownPosition;
@@ -94,20 +101,13 @@ protected:
 	uint32_t m_SquareSize;
 	Piece* m_DraggedPiece;
 	Piece* m_SelectedPiece;
-	Piece* m_WhiteKing;
-	Piece* m_BlackKing;
 	bool m_Flipped;
 	bool m_PointingHand;
-	bool m_WhiteInCheck;
-	bool m_BlackInCheck;
-	bool m_WhiteShort;
-	bool m_WhiteLong;
-	bool m_BlackShort;
-	bool m_BlackLong;
 	bool m_ShowNametag;
 	bool m_ShowLegalMoves;
 	bool m_OnlyLegalMoves;
 	Game* m_Owner;
 	static std::unordered_map<PieceType, char> FEN_Codes;
-	static std::unordered_map<char, PieceType> FEN_Codes_Backwards;
+	static const PieceType PieceTypes[Chess::SIDE_COUNT][Chess::KIND_COUNT];
+	static const Chess::Kind PromotionKinds[4];
 };
\ No newline at end of file
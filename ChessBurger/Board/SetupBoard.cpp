@@ -6,7 +6,7 @@
 #include "Utilities/Utilities.h"
 
 SetupBoard::SetupBoard(const Rectangle& bounds, Game* owner)
-	: IBoard(bounds, owner), m_SelectedPieceType(PieceType::NONE), m_SetupWhitePiecesY(0), m_SetupBlackPiecesY(0), m_SetupPiecesWidth(0), m_SetupPiecesHeight(0), m_SidePanelBounds({}), m_Delete(false), m_DragSetupPiece(false), m_UIWidth(0), m_SideToPlay(0), m_SideToPlayEditMode(false)
+	: IBoard(bounds, owner), m_SelectedPieceType(PieceType::NONE), m_SetupWhitePiecesY(0), m_SetupBlackPiecesY(0), m_SetupPiecesWidth(0), m_SetupPiecesHeight(0), m_SidePanelBounds({}), m_Delete(false), m_DragSetupPiece(false), m_UIWidth(0), m_SideToPlay(0), m_SideToPlayEditMode(false), m_WhiteShort(true), m_WhiteLong(true), m_BlackShort(true), m_BlackLong(true)
 {
 	m_ShowNametag = false;
 	m_OnlyLegalMoves = false;
@@ -169,10 +169,16 @@ void SetupBoard::Update()
 		std::string text = GetClipboardText();
 
 		//Paste FEN
-		if (!LoadFEN(text))
-			//Paste PGN
-			if (!LoadPGN(text))
-				std::invalid_argument("Incorrect FEN or PGN");
+		if (LoadFEN(text))
+		{
+			m_WhiteShort = m_Position.GetCastling() & Chess::WHITE_SHORT;
+			m_WhiteLong = m_Position.GetCastling() & Chess::WHITE_LONG;
+			m_BlackShort = m_Position.GetCastling() & Chess::BLACK_SHORT;
+			m_BlackLong = m_Position.GetCastling() & Chess::BLACK_LONG;
+		}
+		//Paste PGN
+		else if (!LoadPGN(text))
+			std::invalid_argument("Incorrect FEN or PGN");
 	}
 
 	//Update UI
@@ -229,6 +235,7 @@ void SetupBoard::UpdateBounds()
 	m_SelectionFrom.UpdatePosition(m_BoardBounds, m_SquareSize);
 	m_LastMoveFrom.UpdatePosition(m_BoardBounds, m_SquareSize);
 	m_LastMoveTo.UpdatePosition(m_BoardBounds, m_SquareSize);
+	m_CheckHighlight.UpdatePosition(m_BoardBounds, m_SquareSize);
 
 	//Update pieces
 	Piece::Size = PIECE_SIZE_P * (float)m_SquareSize;
@@ -319,6 +326,10 @@ void SetupBoard::Reset(bool resetEnginePosition)
 {
 	IBoard::Reset(resetEnginePosition);
 	m_SelectedPieceType = PieceType::NONE;
+	m_WhiteShort = m_Position.GetCastling() & Chess::WHITE_SHORT;
+	m_WhiteLong = m_Position.GetCastling() & Chess::WHITE_LONG;
+	m_BlackShort = m_Position.GetCastling() & Chess::BLACK_SHORT;
+	m_BlackLong = m_Position.GetCastling() & Chess::BLACK_LONG;
 }
 
 void SetupBoard::SetupPieces_Update()
@@ -46,4 +46,8 @@ private:
 	float m_UIWidth;
 	int m_SideToPlay;
 	bool m_SideToPlayEditMode;
+	bool m_WhiteShort;
+	bool m_WhiteLong;
+	bool m_BlackShort;
+	bool m_BlackLong;
 };
\ No newline at end of file
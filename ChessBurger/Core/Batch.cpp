@@ -0,0 +1,60 @@
+#include "Batch.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace Chess
+{
+	//Positions a worker claims at once, the outputs of two chunks never share a cache line
+	static constexpr size_t BATCH_CHUNK = 256;
+
+	static void _AnalyseRange(const Position* positions, size_t begin, size_t end, PositionInfo* infos, Move* moves)
+	{
+		MoveList list;
+		for (size_t i = begin; i < end; i++)
+		{
+			const Position& position = positions[i];
+			list.Clear();
+			position.GenerateMoves<LEGAL>(list);
+			//Positions set up by FEN may have more moves than a game ever reaches, so a slot fits a full list
+			std::copy(list.begin(), list.end(), moves + i * MoveList::CAPACITY);
+
+			PositionInfo& info = infos[i];
+			info.Attacked = position.GetAttacked();
+			info.Checkers = position.GetCheckers();
+			info.MoveCount = (uint16_t)list.GetSize();
+			info.Status = info.Checkers ? STATUS_CHECK : STATUS_NONE;
+			if (list.IsEmpty())
+				info.Status |= info.Checkers ? STATUS_CHECKMATE : STATUS_STALEMATE;
+			else if (position.GetHalfMoveClock() >= 100)
+				info.Status |= STATUS_FIFTY_MOVES;
+		}
+	}
+
+	void AnalysePositions(const Position* positions, size_t count, PositionInfo* infos, Move* moves, int threads)
+	{
+		if (threads <= 0)
+			threads = (int)std::max(1u, std::thread::hardware_concurrency());
+		threads = (int)std::min((size_t)threads, (count + BATCH_CHUNK - 1) / BATCH_CHUNK);
+		if (threads <= 1)
+		{
+			_AnalyseRange(positions, 0, count, infos, moves);
+			return;
+		}
+
+		//Workers claim the next chunk until the array runs out, the calling thread is one of them
+		std::atomic<size_t> next(0);
+		auto worker = [&]()
+		{
+			for (size_t begin = next.fetch_add(BATCH_CHUNK); begin < count; begin = next.fetch_add(BATCH_CHUNK))
+				_AnalyseRange(positions, begin, std::min(begin + BATCH_CHUNK, count), infos, moves);
+		};
+		std::vector<std::thread> workers;
+		for (int t = 1; t < threads; t++)
+			workers.emplace_back(worker);
+		worker();
+		for (std::thread& thread : workers)
+			thread.join();
+	}
+}
\ No newline at end of file
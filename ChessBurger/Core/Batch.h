@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Position.h"
+#include <cstddef>
+
+namespace Chess
+{
+	//Check and game over flags of a position, seen from the side to move
+	enum PositionStatus : uint8_t
+	{
+		STATUS_NONE = 0, STATUS_CHECK = 1, STATUS_CHECKMATE = 2, STATUS_STALEMATE = 4, STATUS_FIFTY_MOVES = 8
+	};
+
+	struct PositionInfo
+	{
+		Bitboard Attacked; //Squares attacked by the side not to move, through the king of the side to move
+		Bitboard Checkers;
+		uint16_t MoveCount;
+		uint8_t Status;
+	};
+
+	//Fills the info of every position and writes its legal moves from moves[i * MoveList::CAPACITY],
+	//the positions are split between the threads in chunks, all hardware threads are used if it is 0
+	void AnalysePositions(const Position* positions, size_t count, PositionInfo* infos, Move* moves, int threads = 0);
+}
\ No newline at end of file
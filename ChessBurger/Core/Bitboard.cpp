@@ -0,0 +1,117 @@
+#include "Bitboard.h"
+
+namespace Chess
+{
+	Magic BishopMagics[SQUARE_COUNT];
+	Magic RookMagics[SQUARE_COUNT];
+
+	static Bitboard BishopTable[0x1480];
+	static Bitboard RookTable[0x19000];
+
+	static const int BishopDirections[4][2] = { { 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 } };
+	static const int RookDirections[4][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+
+	static Bitboard _SlidingAttacks(Square square, Bitboard occupied, const int directions[4][2])
+	{
+		Bitboard attacks = 0;
+		for (int d = 0; d < 4; d++)
+		{
+			int file = FileOf(square) + directions[d][0];
+			int rank = RankOf(square) + directions[d][1];
+			while (file >= 0 && file < 8 && rank >= 0 && rank < 8)
+			{
+				Bitboard b = SquareBB(MakeSquare(file, rank));
+				attacks |= b;
+				if (occupied & b)
+					break;
+				file += directions[d][0];
+				rank += directions[d][1];
+			}
+		}
+		return attacks;
+	}
+
+	//Xorshift generator, the seeds are chosen so that the magics are found quickly
+	class MagicRandom
+	{
+	public:
+		MagicRandom(uint64_t seed) : m_State(seed) { }
+
+		uint64_t Next()
+		{
+			m_State ^= m_State >> 12;
+			m_State ^= m_State << 25;
+			m_State ^= m_State >> 27;
+			return m_State * 2685821657736338717ULL;
+		}
+		uint64_t Sparse() { return Next() & Next() & Next(); }
+
+	private:
+		uint64_t m_State;
+	};
+
+	static void _InitMagics(Magic magics[], Bitboard table[], const int directions[4][2])
+	{
+		static const uint64_t seeds[8] = { 728, 10316, 55013, 32803, 12281, 15100, 16645, 255 };
+		static Bitboard occupancy[4096], reference[4096];
+		static int epoch[4096];
+		int attempt = 0, size = 0;
+
+		for (int s = A1; s <= H8; s++)
+		{
+			Square square = (Square)s;
+			Magic& magic = magics[s];
+
+			//Board edges are not relevant unless the slider is on them
+			Bitboard edges = ((RANK_1 | RANK_8) & ~RankBB(square)) | ((FILE_A | FILE_H) & ~FileBB(square));
+			magic.Mask = _SlidingAttacks(square, 0, directions) & ~edges;
+			magic.Shift = 64 - PopCount(magic.Mask);
+			magic.Attacks = s == A1 ? table : magics[s - 1].Attacks + size;
+
+			//Enumerate every subset of the mask
+			Bitboard b = 0;
+			size = 0;
+			do
+			{
+				occupancy[size] = b;
+				reference[size] = _SlidingAttacks(square, b, directions);
+#if defined(CHESS_USE_PEXT)
+				magic.Attacks[magic.Index(b)] = reference[size];
+#endif
+				size++;
+				b = (b - magic.Mask) & magic.Mask;
+			} while (b);
+
+#if !defined(CHESS_USE_PEXT)
+			//Try random sparse numbers until one maps every subset without a destructive collision
+			MagicRandom random(seeds[RankOf(square)]);
+			for (int i = 0; i < size;)
+			{
+				for (magic.Number = 0; PopCount((magic.Mask * magic.Number) >> 56) < 6;)
+					magic.Number = random.Sparse();
+
+				for (attempt++, i = 0; i < size; i++)
+				{
+					uint32_t index = magic.Index(occupancy[i]);
+					if (epoch[index] < attempt)
+					{
+						epoch[index] = attempt;
+						magic.Attacks[index] = reference[i];
+					}
+					else if (magic.Attacks[index] != reference[i])
+						break;
+				}
+			}
+#endif
+		}
+	}
+
+	static struct TableInitializer
+	{
+		TableInitializer()
+		{
+			_InitMagics(BishopMagics, BishopTable, BishopDirections);
+			_InitMagics(RookMagics, RookTable, RookDirections);
+		}
+	} tableInitializer;
+}
\ No newline at end of file
@@ -0,0 +1,298 @@
+#pragma once
+
+#include <cstdint>
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+#if defined(__BMI2__)
+	#include <immintrin.h>
+	#define CHESS_USE_PEXT
+#endif
+
+namespace Chess
+{
+	typedef uint64_t Bitboard;
+
+	enum Side : uint8_t
+	{
+		WHITE_SIDE = 0, BLACK_SIDE, SIDE_COUNT
+	};
+
+	enum Kind : uint8_t
+	{
+		PAWN = 0, KNIGHT, BISHOP, ROOK, QUEEN, KING, KIND_COUNT, NO_KIND = KIND_COUNT
+	};
+
+	enum Square : uint8_t
+	{
+		A1, B1, C1, D1, E1, F1, G1, H1,
+		A2, B2, C2, D2, E2, F2, G2, H2,
+		A3, B3, C3, D3, E3, F3, G3, H3,
+		A4, B4, C4, D4, E4, F4, G4, H4,
+		A5, B5, C5, D5, E5, F5, G5, H5,
+		A6, B6, C6, D6, E6, F6, G6, H6,
+		A7, B7, C7, D7, E7, F7, G7, H7,
+		A8, B8, C8, D8, E8, F8, G8, H8,
+		SQUARE_COUNT, NO_SQUARE = SQUARE_COUNT
+	};
+
+	enum Castling : uint8_t
+	{
+		NO_CASTLING = 0, WHITE_SHORT = 1, WHITE_LONG = 2, BLACK_SHORT = 4, BLACK_LONG = 8, ALL_CASTLING = 15
+	};
+
+	constexpr Bitboard FILE_A = 0x0101010101010101ULL;
+	constexpr Bitboard FILE_B = FILE_A << 1;
+	constexpr Bitboard FILE_G = FILE_A << 6;
+	constexpr Bitboard FILE_H = FILE_A << 7;
+	constexpr Bitboard RANK_1 = 0xFFULL;
+	constexpr Bitboard RANK_2 = RANK_1 << 8;
+	constexpr Bitboard RANK_3 = RANK_1 << 16;
+	constexpr Bitboard RANK_6 = RANK_1 << 40;
+	constexpr Bitboard RANK_7 = RANK_1 << 48;
+	constexpr Bitboard RANK_8 = RANK_1 << 56;
+
+	constexpr Side Opposite(Side side) { return (Side)(side ^ 1); }
+	constexpr int FileOf(Square square) { return square & 7; }
+	constexpr int RankOf(Square square) { return square >> 3; }
+	constexpr Square MakeSquare(int file, int rank) { return (Square)(rank * 8 + file); }
+	constexpr Bitboard SquareBB(Square square) { return 1ULL << square; }
+	constexpr Bitboard FileBB(Square square) { return FILE_A << FileOf(square); }
+	constexpr Bitboard RankBB(Square square) { return RANK_1 << (8 * RankOf(square)); }
+
+	inline int PopCount(Bitboard b)
+	{
+#if defined(_MSC_VER)
+		return (int)__popcnt64(b);
+#else
+		return __builtin_popcountll(b);
+#endif
+	}
+
+	inline Square Lsb(Bitboard b)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward64(&index, b);
+		return (Square)index;
+#else
+		return (Square)__builtin_ctzll(b);
+#endif
+	}
+
+	inline Square PopLsb(Bitboard& b)
+	{
+		Square square = Lsb(b);
+		b &= b - 1;
+		return square;
+	}
+
+	//Shifts that drop the squares wrapping around the board edge
+	constexpr Bitboard North(Bitboard b) { return b << 8; }
+	constexpr Bitboard South(Bitboard b) { return b >> 8; }
+	constexpr Bitboard East(Bitboard b) { return (b & ~FILE_H) << 1; }
+	constexpr Bitboard West(Bitboard b) { return (b & ~FILE_A) >> 1; }
+
+	constexpr Bitboard PawnPushes(Side side, Bitboard pawns) { return side == WHITE_SIDE ? North(pawns) : South(pawns); }
+	constexpr Bitboard PawnAttacks(Side side, Bitboard pawns)
+	{
+		return side == WHITE_SIDE ? North(East(pawns) | West(pawns)) : South(East(pawns) | West(pawns));
+	}
+
+	constexpr Bitboard KnightAttacks(Bitboard knights)
+	{
+		Bitboard l1 = (knights >> 1) & ~FILE_H;
+		Bitboard l2 = (knights >> 2) & ~(FILE_G | FILE_H);
+		Bitboard r1 = (knights << 1) & ~FILE_A;
+		Bitboard r2 = (knights << 2) & ~(FILE_A | FILE_B);
+		Bitboard h1 = l1 | r1;
+		Bitboard h2 = l2 | r2;
+		return (h1 << 16) | (h1 >> 16) | (h2 << 8) | (h2 >> 8);
+	}
+
+	constexpr Bitboard KingAttacks(Bitboard kings)
+	{
+		Bitboard row = East(kings) | West(kings) | kings;
+		return (row | North(row) | South(row)) & ~kings;
+	}
+
+	enum Direction : uint8_t
+	{
+		NORTH = 0, SOUTH, EAST, WEST, NORTH_EAST, SOUTH_WEST, NORTH_WEST, SOUTH_EAST, DIRECTION_COUNT
+	};
+
+	constexpr Direction Opposite(Direction direction) { return (Direction)(direction ^ 1); }
+
+	//Lookup tables generated at compile time, they cost nothing at startup
+	template<typename T, int N>
+	struct Table
+	{
+		T Data[N] = {};
+
+		constexpr T& operator[](int i) { return Data[i]; }
+		constexpr const T& operator[](int i) const { return Data[i]; }
+	};
+
+	typedef Table<Bitboard, SQUARE_COUNT> SquareTable;
+	typedef Table<SquareTable, SQUARE_COUNT> SquarePairTable;
+
+	constexpr int DirectionSteps[DIRECTION_COUNT][2] = { { 0, 1 }, { 0, -1 }, { 1, 0 }, { -1, 0 }, { 1, 1 }, { -1, -1 }, { -1, 1 }, { 1, -1 } };
+
+	constexpr SquareTable _GenerateKnightAttacks()
+	{
+		SquareTable table;
+		for (int s = A1; s <= H8; s++)
+			table[s] = KnightAttacks(SquareBB((Square)s));
+		return table;
+	}
+
+	constexpr SquareTable _GenerateKingAttacks()
+	{
+		SquareTable table;
+		for (int s = A1; s <= H8; s++)
+			table[s] = KingAttacks(SquareBB((Square)s));
+		return table;
+	}
+
+	constexpr Table<SquareTable, SIDE_COUNT> _GeneratePawnAttacks()
+	{
+		Table<SquareTable, SIDE_COUNT> table;
+		for (int s = A1; s <= H8; s++)
+		{
+			table[WHITE_SIDE][s] = PawnAttacks(WHITE_SIDE, SquareBB((Square)s));
+			table[BLACK_SIDE][s] = PawnAttacks(BLACK_SIDE, SquareBB((Square)s));
+		}
+		return table;
+	}
+
+	//Squares on an empty board from the square towards the edge, the square itself is not included
+	constexpr Table<SquareTable, DIRECTION_COUNT> _GenerateRays()
+	{
+		Table<SquareTable, DIRECTION_COUNT> table;
+		for (int d = 0; d < DIRECTION_COUNT; d++)
+		{
+			for (int s = A1; s <= H8; s++)
+			{
+				int file = FileOf((Square)s) + DirectionSteps[d][0];
+				int rank = RankOf((Square)s) + DirectionSteps[d][1];
+				for (; file >= 0 && file < 8 && rank >= 0 && rank < 8; file += DirectionSteps[d][0], rank += DirectionSteps[d][1])
+					table[d][s] |= SquareBB(MakeSquare(file, rank));
+			}
+		}
+		return table;
+	}
+
+	constexpr SquarePairTable _GenerateBetween()
+	{
+		SquarePairTable table;
+		for (int s = A1; s <= H8; s++)
+		{
+			for (int d = 0; d < DIRECTION_COUNT; d++)
+			{
+				Bitboard between = 0;
+				int file = FileOf((Square)s) + DirectionSteps[d][0];
+				int rank = RankOf((Square)s) + DirectionSteps[d][1];
+				for (; file >= 0 && file < 8 && rank >= 0 && rank < 8; file += DirectionSteps[d][0], rank += DirectionSteps[d][1])
+				{
+					table[s][MakeSquare(file, rank)] = between;
+					between |= SquareBB(MakeSquare(file, rank));
+				}
+			}
+		}
+		return table;
+	}
+
+	constexpr SquarePairTable _GenerateLines(const Table<SquareTable, DIRECTION_COUNT>& rays)
+	{
+		SquarePairTable table;
+		for (int s = A1; s <= H8; s++)
+		{
+			for (int d = 0; d < DIRECTION_COUNT; d++)
+			{
+				Bitboard line = rays[d][s] | rays[d ^ 1][s] | SquareBB((Square)s);
+				int file = FileOf((Square)s) + DirectionSteps[d][0];
+				int rank = RankOf((Square)s) + DirectionSteps[d][1];
+				for (; file >= 0 && file < 8 && rank >= 0 && rank < 8; file += DirectionSteps[d][0], rank += DirectionSteps[d][1])
+					table[s][MakeSquare(file, rank)] = line;
+			}
+		}
+		return table;
+	}
+
+	constexpr Table<Table<uint8_t, SQUARE_COUNT>, SQUARE_COUNT> _GenerateDistances()
+	{
+		Table<Table<uint8_t, SQUARE_COUNT>, SQUARE_COUNT> table;
+		for (int a = A1; a <= H8; a++)
+		{
+			for (int b = A1; b <= H8; b++)
+			{
+				int files = FileOf((Square)a) - FileOf((Square)b);
+				int ranks = RankOf((Square)a) - RankOf((Square)b);
+				files = files < 0 ? -files : files;
+				ranks = ranks < 0 ? -ranks : ranks;
+				table[a][b] = (uint8_t)(files > ranks ? files : ranks);
+			}
+		}
+		return table;
+	}
+
+	inline constexpr SquareTable KnightTable = _GenerateKnightAttacks();
+	inline constexpr SquareTable KingTable = _GenerateKingAttacks();
+	inline constexpr Table<SquareTable, SIDE_COUNT> PawnTable = _GeneratePawnAttacks();
+	inline constexpr Table<SquareTable, DIRECTION_COUNT> RayTable = _GenerateRays();
+	inline constexpr SquarePairTable BetweenTable = _GenerateBetween();
+	inline constexpr SquarePairTable LineTable = _GenerateLines(RayTable);
+	inline constexpr Table<Table<uint8_t, SQUARE_COUNT>, SQUARE_COUNT> DistanceTable = _GenerateDistances();
+
+	constexpr Bitboard KnightAttacks(Square square) { return KnightTable[square]; }
+	constexpr Bitboard KingAttacks(Square square) { return KingTable[square]; }
+	constexpr Bitboard PawnAttacks(Side side, Square square) { return PawnTable[side][square]; }
+	constexpr Bitboard Ray(Direction direction, Square square) { return RayTable[direction][square]; }
+
+	//Squares strictly between two aligned squares and the full line through them, empty if not aligned
+	constexpr Bitboard Between(Square a, Square b) { return BetweenTable[a][b]; }
+	constexpr Bitboard Line(Square a, Square b) { return LineTable[a][b]; }
+
+	//King steps needed to get from one square to the other
+	constexpr int Distance(Square a, Square b) { return DistanceTable[a][b]; }
+
+	//Fancy magic bitboards, the relevant occupancy of a slider is hashed into its own slice of the attack table
+	//With BMI2 the index is a PEXT of the occupancy instead of a multiplication
+	struct Magic
+	{
+		Bitboard Mask;
+		Bitboard Number;
+		Bitboard* Attacks;
+		uint32_t Shift;
+
+		uint32_t Index(Bitboard occupied) const
+		{
+#if defined(CHESS_USE_PEXT)
+			return (uint32_t)_pext_u64(occupied, Mask);
+#else
+			return (uint32_t)(((occupied & Mask) * Number) >> Shift);
+#endif
+		}
+	};
+
+	extern Magic BishopMagics[SQUARE_COUNT];
+	extern Magic RookMagics[SQUARE_COUNT];
+
+	inline Bitboard BishopAttacks(Square square, Bitboard occupied) { return BishopMagics[square].Attacks[BishopMagics[square].Index(occupied)]; }
+	inline Bitboard RookAttacks(Square square, Bitboard occupied) { return RookMagics[square].Attacks[RookMagics[square].Index(occupied)]; }
+	inline Bitboard QueenAttacks(Square square, Bitboard occupied) { return BishopAttacks(square, occupied) | RookAttacks(square, occupied); }
+
+	//Attacks of any piece but the pawn, whose attacks depend on its side
+	inline Bitboard PieceAttacks(Kind kind, Square square, Bitboard occupied)
+	{
+		switch (kind)
+		{
+		case KNIGHT: return KnightAttacks(square);
+		case BISHOP: return BishopAttacks(square, occupied);
+		case ROOK: return RookAttacks(square, occupied);
+		case QUEEN: return QueenAttacks(square, occupied);
+		case KING: return KingAttacks(square);
+		default: return 0;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include "Evaluation.h"
+#include <algorithm>
+
+namespace Chess
+{
+	static constexpr Score PassedBonus[8] =
+	{
+		MakeScore(0, 0), MakeScore(5, 10), MakeScore(5, 15), MakeScore(10, 25),
+		MakeScore(20, 45), MakeScore(35, 75), MakeScore(60, 120), MakeScore(0, 0)
+	};
+	static constexpr int MobilityWeights[KIND_COUNT] = { 0, 4, 5, 2, 1, 0 };
+	static constexpr Score DOUBLED_PENALTY = MakeScore(10, 20);
+	static constexpr Score ISOLATED_PENALTY = MakeScore(10, 15);
+	static constexpr Score BISHOP_PAIR_BONUS = MakeScore(30, 50);
+	//Pawns right in front of the king keep it safe while there are pieces to attack it
+	static constexpr Score SHIELD_BONUS = MakeScore(10, 0);
+
+	//Squares in front of a pawn on its own and the neighbouring files, no enemy pawn there means it is passed
+	static constexpr Table<SquareTable, SIDE_COUNT> _GeneratePassedMasks()
+	{
+		Table<SquareTable, SIDE_COUNT> table;
+		for (int s = A1; s <= H8; s++)
+		{
+			Bitboard files = FileBB((Square)s);
+			files |= ((files & ~FILE_A) >> 1) | ((files & ~FILE_H) << 1);
+			for (int rank = 0; rank < 8; rank++)
+			{
+				if (rank > RankOf((Square)s))
+					table[WHITE_SIDE][s] |= files & (RANK_1 << (8 * rank));
+				else if (rank < RankOf((Square)s))
+					table[BLACK_SIDE][s] |= files & (RANK_1 << (8 * rank));
+			}
+		}
+		return table;
+	}
+
+	static constexpr Table<SquareTable, SIDE_COUNT> PassedMasks = _GeneratePassedMasks();
+
+	PawnHash::PawnHash()
+		: m_Entries(SIZE, Entry{ 0, 0 })
+	{
+	}
+
+	//A position without pawns has the key 0, which is also the key of the empty entries, its score is 0 either way
+	bool PawnHash::Probe(uint64_t key, Score& score) const
+	{
+		const Entry& entry = m_Entries[key & (SIZE - 1)];
+		if (entry.Key != key)
+			return false;
+		score = entry.Value;
+		return true;
+	}
+
+	void PawnHash::Store(uint64_t key, Score score)
+	{
+		m_Entries[key & (SIZE - 1)] = Entry{ key, score };
+	}
+
+	static Score _EvaluatePawns(const Position& position, Side side)
+	{
+		Bitboard pawns = position.GetPieces(side, PAWN);
+		Bitboard enemyPawns = position.GetPieces(Opposite(side), PAWN);
+		Score score = 0;
+		for (Bitboard b = pawns; b;)
+		{
+			Square square = PopLsb(b);
+			Bitboard file = FileBB(square);
+			Bitboard neighbours = ((file & ~FILE_A) >> 1) | ((file & ~FILE_H) << 1);
+			if (!(pawns & neighbours))
+				score -= ISOLATED_PENALTY;
+			if (!(enemyPawns & PassedMasks[side][square]))
+				score += PassedBonus[side == WHITE_SIDE ? RankOf(square) : 7 - RankOf(square)];
+		}
+		for (int file = 0; file < 8; file++)
+		{
+			int count = PopCount(pawns & (FILE_A << file));
+			if (count > 1)
+				score -= DOUBLED_PENALTY * (count - 1);
+		}
+		return score;
+	}
+
+	//The pieces only, the material and the placement are kept up to date by the position
+	static Score _EvaluatePieces(const Position& position, Side side)
+	{
+		Bitboard occupied = position.GetPieces();
+		Bitboard own = position.GetPieces(side);
+		Bitboard enemyPawns = position.GetPieces(Opposite(side), PAWN);
+		Bitboard enemyPawnAttacks = side == WHITE_SIDE
+			? ((enemyPawns & ~FILE_A) >> 9) | ((enemyPawns & ~FILE_H) >> 7)
+			: ((enemyPawns & ~FILE_A) << 7) | ((enemyPawns & ~FILE_H) << 9);
+
+		int mobility = 0;
+		for (int k = KNIGHT; k <= QUEEN; k++)
+		{
+			for (Bitboard b = position.GetPieces(side, (Kind)k); b;)
+				mobility += MobilityWeights[k] * PopCount(PieceAttacks((Kind)k, PopLsb(b), occupied) & ~own & ~enemyPawnAttacks);
+		}
+
+		Score score = MakeScore(mobility, mobility);
+		if (PopCount(position.GetPieces(side, BISHOP)) >= 2)
+			score += BISHOP_PAIR_BONUS;
+		//The squares in front of the king are the ones next to it that are in front of a pawn on its square
+		Square king = position.GetKingSquare(side);
+		score += SHIELD_BONUS * PopCount(KingAttacks(king) & PassedMasks[side][king] & position.GetPieces(side, PAWN));
+		return score;
+	}
+
+	static int _Evaluate(const Position& position, PawnHash* pawns)
+	{
+		Score pawnScore;
+		if (!pawns || !pawns->Probe(position.GetPawnKey(), pawnScore))
+		{
+			pawnScore = _EvaluatePawns(position, WHITE_SIDE) - _EvaluatePawns(position, BLACK_SIDE);
+			if (pawns)
+				pawns->Store(position.GetPawnKey(), pawnScore);
+		}
+
+		Score score = position.GetPieceSquare() + pawnScore + _EvaluatePieces(position, WHITE_SIDE) - _EvaluatePieces(position, BLACK_SIDE);
+		int phase = std::min(position.GetPhase(), PHASE_MAX);
+		int value = (MiddlegameOf(score) * phase + EndgameOf(score) * (PHASE_MAX - phase)) / PHASE_MAX;
+		return position.GetSideToMove() == WHITE_SIDE ? value : -value;
+	}
+
+	int Evaluate(const Position& position)
+	{
+		return _Evaluate(position, nullptr);
+	}
+
+	int Evaluate(const Position& position, PawnHash& pawns)
+	{
+		return _Evaluate(position, &pawns);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Position.h"
+#include <vector>
+
+namespace Chess
+{
+	//Pawn structure scores by the pawn key, each search thread has its own
+	class PawnHash
+	{
+	public:
+		static constexpr size_t SIZE = 1 << 14;
+
+	public:
+		PawnHash();
+
+		bool Probe(uint64_t key, Score& score) const;
+		void Store(uint64_t key, Score score);
+
+	private:
+		struct Entry
+		{
+			uint64_t Key;
+			Score Value;
+		};
+
+	private:
+		std::vector<Entry> m_Entries;
+	};
+
+	//Static evaluation in centipawns from the point of view of the side to move
+	//It tapers between the middlegame and the endgame score by the material left on the board
+	int Evaluate(const Position& position);
+	int Evaluate(const Position& position, PawnHash& pawns);
+}
\ No newline at end of file
@@ -0,0 +1,16 @@
+#include "Move.h"
+
+namespace Chess
+{
+	std::string ToUCI(const Move& move)
+	{
+		std::string uci;
+		uci += (char)('a' + FileOf(move.GetFrom()));
+		uci += (char)('1' + RankOf(move.GetFrom()));
+		uci += (char)('a' + FileOf(move.GetTo()));
+		uci += (char)('1' + RankOf(move.GetTo()));
+		if (move.GetType() == MOVE_PROMOTION)
+			uci += "pnbrqk"[move.GetPromotion()];
+		return uci;
+	}
+}
\ No newline at end of file
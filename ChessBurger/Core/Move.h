@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Bitboard.h"
+#include <string>
+
+namespace Chess
+{
+	enum MoveType : uint16_t
+	{
+		MOVE_NORMAL = 0, MOVE_PROMOTION = 1 << 14, MOVE_EN_PASSANT = 2 << 14, MOVE_CASTLING = 3 << 14
+	};
+
+	//Packed into 16 bits: origin square in bits 0-5, target square in bits 6-11, promotion kind in bits 12-13 and the move type in bits 14-15
+	class Move
+	{
+	public:
+		Move() = default;
+		constexpr Move(Square from, Square to, MoveType type = MOVE_NORMAL, Kind promotion = KNIGHT)
+			: m_Data((uint16_t)(from | (to << 6) | ((promotion - KNIGHT) << 12) | type)) { }
+
+		constexpr Square GetFrom() const { return (Square)(m_Data & 0x3F); }
+		constexpr Square GetTo() const { return (Square)((m_Data >> 6) & 0x3F); }
+		constexpr MoveType GetType() const { return (MoveType)(m_Data & (3 << 14)); }
+		constexpr Kind GetPromotion() const { return GetType() == MOVE_PROMOTION ? (Kind)(((m_Data >> 12) & 3) + KNIGHT) : NO_KIND; }
+		constexpr uint16_t GetData() const { return m_Data; }
+
+		constexpr bool operator==(const Move& other) const { return m_Data == other.m_Data; }
+		constexpr bool operator!=(const Move& other) const { return m_Data != other.m_Data; }
+
+		//A1 to A1 can never be played
+		static constexpr Move None() { return Move(A1, A1); }
+		//Inverse of GetData
+		static constexpr Move FromData(uint16_t data) { Move move = None(); move.m_Data = data; return move; }
+
+	private:
+		uint16_t m_Data;
+	};
+
+	//No position has more than 218 legal moves
+	constexpr int MAX_MOVES = 218;
+
+	//Fixed capacity list on the stack
+	class MoveList
+	{
+	public:
+		static constexpr int CAPACITY = 256;
+
+	public:
+		MoveList() : m_Size(0) { }
+
+		void Add(const Move& move) { m_Moves[m_Size++] = move; }
+		void Clear() { m_Size = 0; }
+		int GetSize() const { return m_Size; }
+		bool IsEmpty() const { return m_Size == 0; }
+		bool Contains(const Move& move) const;
+
+		const Move& operator[](int index) const { return m_Moves[index]; }
+		const Move* begin() const { return m_Moves; }
+		const Move* end() const { return m_Moves + m_Size; }
+
+	private:
+		Move m_Moves[CAPACITY];
+		int m_Size;
+	};
+
+	inline bool MoveList::Contains(const Move& move) const
+	{
+		for (int i = 0; i < m_Size; i++)
+			if (m_Moves[i] == move)
+				return true;
+		return false;
+	}
+
+	std::string ToUCI(const Move& move);
+}
\ No newline at end of file
@@ -0,0 +1,392 @@
+#include "Network.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+	#define CHESS_USE_X86
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#include <immintrin.h>
+	#endif
+#endif
+
+//The kernels are compiled for their instruction set one by one, the rest of the library stays portable
+#if defined(_MSC_VER) && !defined(__clang__)
+	#define CHESS_TARGET(instructions)
+#else
+	#define CHESS_TARGET(instructions) __attribute__((target(instructions)))
+#endif
+
+namespace Chess
+{
+	static constexpr int FEATURE_PIECES = 641;
+	//Fixed point shift of the hidden layers
+	static constexpr int WEIGHT_SCALE_BITS = 6;
+	//The output is 16 times the value in units where an endgame pawn is 208
+	static constexpr int OUTPUT_SCALE = 16;
+	static constexpr int PAWN_UNITS = 208;
+
+	struct Network::Weights
+	{
+		alignas(64) int16_t FeatureBiases[NETWORK_HALF];
+		alignas(64) int16_t FeatureWeights[NETWORK_INPUTS * NETWORK_HALF];
+		alignas(64) int32_t HiddenBiases1[NETWORK_HIDDEN];
+		alignas(64) int8_t HiddenWeights1[NETWORK_HIDDEN * 2 * NETWORK_HALF];
+		alignas(64) int32_t HiddenBiases2[NETWORK_HIDDEN];
+		alignas(64) int8_t HiddenWeights2[NETWORK_HIDDEN * NETWORK_HIDDEN];
+		alignas(64) int32_t OutputBias;
+		alignas(64) int8_t OutputWeights[NETWORK_HIDDEN];
+	};
+
+	//Rows of the first layer are added to and taken from the accumulators, the dense layers multiply 8 bit activations by 8 bit weights
+	struct Kernels
+	{
+		const char* Name;
+		void (*AddRow)(int16_t* values, const int16_t* row);
+		void (*SubtractRow)(int16_t* values, const int16_t* row);
+		void (*Affine)(const uint8_t* input, const int8_t* weights, const int32_t* biases, int32_t* output, int inputs, int outputs);
+	};
+
+	static void _AddRowScalar(int16_t* values, const int16_t* row)
+	{
+		for (int i = 0; i < NETWORK_HALF; i++)
+			values[i] += row[i];
+	}
+
+	static void _SubtractRowScalar(int16_t* values, const int16_t* row)
+	{
+		for (int i = 0; i < NETWORK_HALF; i++)
+			values[i] -= row[i];
+	}
+
+	static void _AffineScalar(const uint8_t* input, const int8_t* weights, const int32_t* biases, int32_t* output, int inputs, int outputs)
+	{
+		for (int o = 0; o < outputs; o++)
+		{
+			int32_t sum = biases[o];
+			for (int i = 0; i < inputs; i++)
+				sum += input[i] * weights[o * inputs + i];
+			output[o] = sum;
+		}
+	}
+
+#if defined(CHESS_USE_X86)
+	CHESS_TARGET("sse4.1")
+	static void _AddRowSSE41(int16_t* values, const int16_t* row)
+	{
+		for (int i = 0; i < NETWORK_HALF; i += 8)
+		{
+			__m128i* target = (__m128i*)(values + i);
+			_mm_store_si128(target, _mm_add_epi16(_mm_load_si128(target), _mm_loadu_si128((const __m128i*)(row + i))));
+		}
+	}
+
+	CHESS_TARGET("sse4.1")
+	static void _SubtractRowSSE41(int16_t* values, const int16_t* row)
+	{
+		for (int i = 0; i < NETWORK_HALF; i += 8)
+		{
+			__m128i* target = (__m128i*)(values + i);
+			_mm_store_si128(target, _mm_sub_epi16(_mm_load_si128(target), _mm_loadu_si128((const __m128i*)(row + i))));
+		}
+	}
+
+	//The inputs are at most 127, so the pairwise sums of the products never saturate
+	CHESS_TARGET("sse4.1")
+	static void _AffineSSE41(const uint8_t* input, const int8_t* weights, const int32_t* biases, int32_t* output, int inputs, int outputs)
+	{
+		const __m128i ones = _mm_set1_epi16(1);
+		for (int o = 0; o < outputs; o++)
+		{
+			const int8_t* row = weights + o * inputs;
+			__m128i sum = _mm_setzero_si128();
+			for (int i = 0; i < inputs; i += 16)
+			{
+				__m128i products = _mm_maddubs_epi16(_mm_loadu_si128((const __m128i*)(input + i)), _mm_loadu_si128((const __m128i*)(row + i)));
+				sum = _mm_add_epi32(sum, _mm_madd_epi16(products, ones));
+			}
+			sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+			sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+			output[o] = biases[o] + _mm_cvtsi128_si32(sum);
+		}
+	}
+
+	CHESS_TARGET("avx2")
+	static void _AddRowAVX2(int16_t* values, const int16_t* row)
+	{
+		for (int i = 0; i < NETWORK_HALF; i += 16)
+		{
+			__m256i* target = (__m256i*)(values + i);
+			_mm256_store_si256(target, _mm256_add_epi16(_mm256_load_si256(target), _mm256_loadu_si256((const __m256i*)(row + i))));
+		}
+	}
+
+	CHESS_TARGET("avx2")
+	static void _SubtractRowAVX2(int16_t* values, const int16_t* row)
+	{
+		for (int i = 0; i < NETWORK_HALF; i += 16)
+		{
+			__m256i* target = (__m256i*)(values + i);
+			_mm256_store_si256(target, _mm256_sub_epi16(_mm256_load_si256(target), _mm256_loadu_si256((const __m256i*)(row + i))));
+		}
+	}
+
+	CHESS_TARGET("avx2")
+	static void _AffineAVX2(const uint8_t* input, const int8_t* weights, const int32_t* biases, int32_t* output, int inputs, int outputs)
+	{
+		const __m256i ones = _mm256_set1_epi16(1);
+		for (int o = 0; o < outputs; o++)
+		{
+			const int8_t* row = weights + o * inputs;
+			__m256i sum = _mm256_setzero_si256();
+			for (int i = 0; i < inputs; i += 32)
+			{
+				__m256i products = _mm256_maddubs_epi16(_mm256_loadu_si256((const __m256i*)(input + i)), _mm256_loadu_si256((const __m256i*)(row + i)));
+				sum = _mm256_add_epi32(sum, _mm256_madd_epi16(products, ones));
+			}
+			__m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+			half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0x4E));
+			half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0xB1));
+			output[o] = biases[o] + _mm_cvtsi128_si32(half);
+		}
+	}
+
+	static bool _SupportsAVX2()
+	{
+#if defined(_MSC_VER)
+		//The processor has to support it and the system has to save the registers
+		int info[4];
+		__cpuid(info, 1);
+		if (!(info[2] & (1 << 27)) || (_xgetbv(0) & 6) != 6)
+			return false;
+		__cpuidex(info, 7, 0);
+		return info[1] & (1 << 5);
+#else
+		return __builtin_cpu_supports("avx2");
+#endif
+	}
+
+	static bool _SupportsSSE41()
+	{
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 1);
+		return info[2] & (1 << 19);
+#else
+		return __builtin_cpu_supports("sse4.1");
+#endif
+	}
+#endif
+
+	//Every kernel set the processor supports, the fastest first
+	static const std::vector<Kernels>& _GetSupportedKernels()
+	{
+		static const std::vector<Kernels> supported = []()
+		{
+			std::vector<Kernels> kernels;
+#if defined(CHESS_USE_X86)
+			if (_SupportsAVX2())
+				kernels.push_back({ "AVX2", _AddRowAVX2, _SubtractRowAVX2, _AffineAVX2 });
+			if (_SupportsSSE41())
+				kernels.push_back({ "SSE4.1", _AddRowSSE41, _SubtractRowSSE41, _AffineSSE41 });
+#endif
+			kernels.push_back({ "scalar", _AddRowScalar, _SubtractRowScalar, _AffineScalar });
+			return kernels;
+		}();
+		return supported;
+	}
+
+	//Index of the kernels in use, the fastest unless others are selected
+	static std::atomic<size_t> SelectedKernels(0);
+
+	static const Kernels& _GetKernels()
+	{
+		return _GetSupportedKernels()[SelectedKernels.load(std::memory_order_relaxed)];
+	}
+
+	//Squares are turned around for black, so both perspectives see the board from their own side
+	static int _FeatureIndex(Side perspective, Square king, Side side, Kind kind, Square square)
+	{
+		int orient = perspective == WHITE_SIDE ? 0 : 63;
+		return (square ^ orient) + 1 + kind * 128 + (side != perspective ? 64 : 0) + FEATURE_PIECES * (king ^ orient);
+	}
+
+	static void _ClippedReLU(const int32_t* input, uint8_t* output, int count)
+	{
+		for (int i = 0; i < count; i++)
+			output[i] = (uint8_t)std::clamp(input[i] >> WEIGHT_SCALE_BITS, 0, 127);
+	}
+
+	//The files are little endian like the processors the program runs on
+	template<typename T>
+	static bool _Read(std::istream& stream, T* data, size_t count)
+	{
+		stream.read((char*)data, sizeof(T) * count);
+		return (bool)stream;
+	}
+
+	Network::Network()
+		: m_Weights(nullptr)
+	{
+	}
+
+	Network::~Network() = default;
+
+	bool Network::Load(const std::string& path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		return file && Load(file);
+	}
+
+	bool Network::Load(std::istream& stream)
+	{
+		//Header with a version, a hash of the architecture and a description, then the hash of every part before it
+		uint32_t version, hash, length;
+		if (!_Read(stream, &version, 1) || version != NETWORK_VERSION || !_Read(stream, &hash, 1) || !_Read(stream, &length, 1))
+			return false;
+		stream.ignore(length);
+
+		auto weights = std::make_unique<Weights>();
+		bool valid = _Read(stream, &hash, 1)
+			&& _Read(stream, weights->FeatureBiases, NETWORK_HALF)
+			&& _Read(stream, weights->FeatureWeights, (size_t)NETWORK_INPUTS * NETWORK_HALF)
+			&& _Read(stream, &hash, 1)
+			&& _Read(stream, weights->HiddenBiases1, NETWORK_HIDDEN)
+			&& _Read(stream, weights->HiddenWeights1, NETWORK_HIDDEN * 2 * NETWORK_HALF)
+			&& _Read(stream, weights->HiddenBiases2, NETWORK_HIDDEN)
+			&& _Read(stream, weights->HiddenWeights2, NETWORK_HIDDEN * NETWORK_HIDDEN)
+			&& _Read(stream, &weights->OutputBias, 1)
+			&& _Read(stream, weights->OutputWeights, NETWORK_HIDDEN);
+
+		//A file of another architecture would not end right here
+		if (!valid || stream.peek() != std::char_traits<char>::eof())
+			return false;
+		m_Weights = std::move(weights);
+		return true;
+	}
+
+	const char* Network::GetKernelName()
+	{
+		return _GetKernels().Name;
+	}
+
+	std::vector<std::string> Network::GetSupportedKernels()
+	{
+		std::vector<std::string> names;
+		for (const Kernels& kernels : _GetSupportedKernels())
+			names.push_back(kernels.Name);
+		return names;
+	}
+
+	bool Network::SelectKernels(const std::string& name)
+	{
+		const std::vector<Kernels>& supported = _GetSupportedKernels();
+		for (size_t i = 0; i < supported.size(); i++)
+		{
+			if (name == supported[i].Name)
+			{
+				SelectedKernels = i;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void Network::Refresh(const Position& position, Accumulator& accumulator) const
+	{
+		_Refresh(position, accumulator, WHITE_SIDE);
+		_Refresh(position, accumulator, BLACK_SIDE);
+	}
+
+	void Network::Update(const Accumulator& parent, Accumulator& child, const Position& position, const Move& move, const UndoInfo& undo) const
+	{
+		struct Change
+		{
+			Side Owner;
+			Kind Piece;
+			Square Location;
+		};
+
+		Side them = position.GetSideToMove();
+		Side us = Opposite(them);
+		Square from = move.GetFrom(), to = move.GetTo();
+		Kind placed = position.GetKindOn(to);
+		Kind kind = move.GetType() == MOVE_PROMOTION ? PAWN : placed;
+
+		//At most two pieces leave and two arrive, the kings are not inputs
+		Change removed[2], added[2];
+		int removedCount = 0, addedCount = 0;
+		if (kind != KING)
+		{
+			removed[removedCount++] = { us, kind, from };
+			added[addedCount++] = { us, placed, to };
+		}
+		if (undo.Captured != NO_KIND)
+			removed[removedCount++] = { them, undo.Captured, move.GetType() == MOVE_EN_PASSANT ? (Square)(us == WHITE_SIDE ? to - 8 : to + 8) : to };
+		if (move.GetType() == MOVE_CASTLING)
+		{
+			bool kingSide = to > from;
+			removed[removedCount++] = { us, ROOK, (Square)(kingSide ? to + 1 : to - 2) };
+			added[addedCount++] = { us, ROOK, (Square)(kingSide ? to - 1 : to + 1) };
+		}
+
+		const Kernels& kernels = _GetKernels();
+		for (Side perspective : { WHITE_SIDE, BLACK_SIDE })
+		{
+			//Every input of the side depends on its king square
+			if (kind == KING && perspective == us)
+			{
+				_Refresh(position, child, perspective);
+				continue;
+			}
+
+			Square king = position.GetKingSquare(perspective);
+			int16_t* values = child.Values[perspective];
+			std::memcpy(values, parent.Values[perspective], sizeof(child.Values[perspective]));
+			for (int i = 0; i < removedCount; i++)
+				kernels.SubtractRow(values, m_Weights->FeatureWeights + (size_t)_FeatureIndex(perspective, king, removed[i].Owner, removed[i].Piece, removed[i].Location) * NETWORK_HALF);
+			for (int i = 0; i < addedCount; i++)
+				kernels.AddRow(values, m_Weights->FeatureWeights + (size_t)_FeatureIndex(perspective, king, added[i].Owner, added[i].Piece, added[i].Location) * NETWORK_HALF);
+		}
+	}
+
+	int Network::Evaluate(const Accumulator& accumulator, Side sideToMove) const
+	{
+		const Kernels& kernels = _GetKernels();
+
+		//The half of the side to move comes first
+		alignas(64) uint8_t input[2 * NETWORK_HALF];
+		for (int p = 0; p < SIDE_COUNT; p++)
+		{
+			const int16_t* values = accumulator.Values[p == 0 ? sideToMove : Opposite(sideToMove)];
+			for (int i = 0; i < NETWORK_HALF; i++)
+				input[p * NETWORK_HALF + i] = (uint8_t)std::clamp<int>(values[i], 0, 127);
+		}
+
+		alignas(64) int32_t hidden[NETWORK_HIDDEN];
+		alignas(64) uint8_t activated[NETWORK_HIDDEN];
+		kernels.Affine(input, m_Weights->HiddenWeights1, m_Weights->HiddenBiases1, hidden, 2 * NETWORK_HALF, NETWORK_HIDDEN);
+		_ClippedReLU(hidden, activated, NETWORK_HIDDEN);
+		kernels.Affine(activated, m_Weights->HiddenWeights2, m_Weights->HiddenBiases2, hidden, NETWORK_HIDDEN, NETWORK_HIDDEN);
+		_ClippedReLU(hidden, activated, NETWORK_HIDDEN);
+		int32_t output;
+		kernels.Affine(activated, m_Weights->OutputWeights, &m_Weights->OutputBias, &output, NETWORK_HIDDEN, 1);
+		return output / OUTPUT_SCALE * 100 / PAWN_UNITS;
+	}
+
+	void Network::_Refresh(const Position& position, Accumulator& accumulator, Side perspective) const
+	{
+		const Kernels& kernels = _GetKernels();
+		int16_t* values = accumulator.Values[perspective];
+		std::memcpy(values, m_Weights->FeatureBiases, sizeof(accumulator.Values[perspective]));
+		Square king = position.GetKingSquare(perspective);
+		for (Bitboard pieces = position.GetPieces() & ~position.GetPieces(KING); pieces;)
+		{
+			Square square = PopLsb(pieces);
+			size_t index = _FeatureIndex(perspective, king, position.GetSideOn(square), position.GetKindOn(square), square);
+			kernels.AddRow(values, m_Weights->FeatureWeights + index * NETWORK_HALF);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Position.h"
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Chess
+{
+	//HalfKP network in the format of the first NNUE files: 41024 inputs per perspective, 256x2 -> 32 -> 32 -> 1
+	//An input is a piece other than a king on a square, seen from the square of the king of the perspective
+	constexpr uint32_t NETWORK_VERSION = 0x7AF32F16;
+	constexpr int NETWORK_INPUTS = 64 * 641;
+	constexpr int NETWORK_HALF = 256;
+	constexpr int NETWORK_HIDDEN = 32;
+
+	//First layer sums of both perspectives, the search keeps one per ply and updates it move by move
+	struct alignas(64) Accumulator
+	{
+		int16_t Values[SIDE_COUNT][NETWORK_HALF];
+	};
+
+	class Network
+	{
+	public:
+		Network();
+		~Network();
+
+		//The weights are only replaced if the whole file is valid
+		bool Load(const std::string& path);
+		bool Load(std::istream& stream);
+		bool IsLoaded() const;
+		//Name of the kernels in use, the fastest the processor supports unless others are selected: "AVX2", "SSE4.1" or "scalar"
+		static const char* GetKernelName();
+		static std::vector<std::string> GetSupportedKernels();
+		//Every kernel gives the same results, selecting one is for comparing them and must not overlap an evaluation
+		static bool SelectKernels(const std::string& name);
+
+		void Refresh(const Position& position, Accumulator& accumulator) const;
+		//Child from the parent after the move is made, the perspective whose king moved is refreshed
+		void Update(const Accumulator& parent, Accumulator& child, const Position& position, const Move& move, const UndoInfo& undo) const;
+		//Centipawns from the point of view of the side to move
+		int Evaluate(const Accumulator& accumulator, Side sideToMove) const;
+
+	private:
+		struct Weights;
+
+	private:
+		void _Refresh(const Position& position, Accumulator& accumulator, Side perspective) const;
+
+	private:
+		std::unique_ptr<Weights> m_Weights;
+	};
+
+	inline bool Network::IsLoaded() const { return m_Weights != nullptr; }
+}
\ No newline at end of file
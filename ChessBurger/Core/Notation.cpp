@@ -0,0 +1,273 @@
+#include "Notation.h"
+#include <cstring>
+
+namespace Chess
+{
+	static constexpr char PIECE_LETTERS[] = "PNBRQK";
+
+	//Character classes of the SAN parser, the value is the file, the rank or the kind
+	enum SANClass : uint8_t
+	{
+		SAN_OTHER = 0, SAN_FILE, SAN_RANK, SAN_PIECE, SAN_SEPARATOR, SAN_SUFFIX
+	};
+
+	struct SANChar
+	{
+		uint8_t Class = SAN_OTHER;
+		uint8_t Value = 0;
+	};
+
+	static constexpr Table<SANChar, 256> _GenerateSANChars()
+	{
+		Table<SANChar, 256> chars;
+		for (int i = 0; i < 8; i++)
+		{
+			chars['a' + i] = { SAN_FILE, (uint8_t)i };
+			chars['1' + i] = { SAN_RANK, (uint8_t)i };
+		}
+		for (int k = PAWN; k <= KING; k++)
+			chars[PIECE_LETTERS[k]] = { SAN_PIECE, (uint8_t)k };
+		for (char c : { 'x', ':', '-' })
+			chars[c] = { SAN_SEPARATOR, 0 };
+		for (char c : { '+', '#', '!', '?' })
+			chars[c] = { SAN_SUFFIX, 0 };
+		return chars;
+	}
+
+	static constexpr Table<SANChar, 256> SANChars = _GenerateSANChars();
+
+	static const SANChar& _Classify(char c) { return SANChars[(uint8_t)c]; }
+
+	static bool _IsResult(std::string_view token)
+	{
+		return token == "1-0" || token == "0-1" || token == "1/2-1/2" || token == "*";
+	}
+
+	std::string ToSquareName(Square square)
+	{
+		return { (char)('a' + FileOf(square)), (char)('1' + RankOf(square)) };
+	}
+
+	static char* _WriteSquare(char* out, Square square)
+	{
+		*out++ = (char)('a' + FileOf(square));
+		*out++ = (char)('1' + RankOf(square));
+		return out;
+	}
+
+	int WriteSAN(const Position& position, const Move& move, char* buffer)
+	{
+		char* out = buffer;
+		Square from = move.GetFrom(), to = move.GetTo();
+		Kind kind = position.GetKindOn(from);
+		bool capture = position.IsCapture(move);
+
+		if (move.GetType() == MOVE_CASTLING)
+		{
+			memcpy(out, "O-O-O", 5);
+			out += to > from ? 3 : 5;
+		}
+		else if (kind == PAWN)
+		{
+			if (capture)
+			{
+				*out++ = (char)('a' + FileOf(from));
+				*out++ = 'x';
+			}
+			out = _WriteSquare(out, to);
+			if (move.GetType() == MOVE_PROMOTION)
+			{
+				*out++ = '=';
+				*out++ = PIECE_LETTERS[move.GetPromotion()];
+			}
+		}
+		else
+		{
+			*out++ = PIECE_LETTERS[kind];
+
+			//Other pieces of the same kind reaching the target, a pinned one only if the target is on the line of its king
+			Side us = position.GetSideToMove();
+			Bitboard others = PieceAttacks(kind, to, position.GetPieces()) & (position.GetPieces(us, kind) ^ SquareBB(from));
+			others &= ~position.GetPinned() | Line(position.GetKingSquare(us), to);
+			if (others)
+			{
+				if (!(others & FileBB(from)))
+					*out++ = (char)('a' + FileOf(from));
+				else if (!(others & RankBB(from)))
+					*out++ = (char)('1' + RankOf(from));
+				else
+					out = _WriteSquare(out, from);
+			}
+
+			if (capture)
+				*out++ = 'x';
+			out = _WriteSquare(out, to);
+		}
+
+		//Check and checkmate, only a checking move has to look at the replies
+		if (position.GivesCheck(move))
+		{
+			Position after = position;
+			UndoInfo undo;
+			after.MakeMove(move, undo);
+			*out++ = after.HasLegalMove() ? '+' : '#';
+		}
+		*out = '\0';
+		return (int)(out - buffer);
+	}
+
+	std::string ToSAN(const Position& position, const Move& move)
+	{
+		char san[MAX_SAN_LENGTH];
+		return std::string(san, WriteSAN(position, move, san));
+	}
+
+	Move FromSAN(const Position& position, std::string_view san)
+	{
+		//Drop the check sign and the annotations
+		while (!san.empty() && _Classify(san.back()).Class == SAN_SUFFIX)
+			san.remove_suffix(1);
+		if (san.empty())
+			return Move::None();
+
+		Side us = position.GetSideToMove();
+		MoveList moves;
+
+		//Castling, written with letters or zeros
+		if (san[0] == 'O' || san[0] == '0')
+		{
+			if (san != "O-O" && san != "0-0" && san != "O-O-O" && san != "0-0-0")
+				return Move::None();
+			bool kingSide = san.size() == 3;
+			position.GenerateMoves<QUIETS>(moves, position.GetPieces(us, KING));
+			for (const Move& move : moves)
+				if (move.GetType() == MOVE_CASTLING && (move.GetTo() > move.GetFrom()) == kingSide)
+					return move;
+			return Move::None();
+		}
+
+		//Promotion, written as e8=Q or e8Q
+		Kind promotion = NO_KIND;
+		if (_Classify(san.back()).Class == SAN_PIECE)
+		{
+			promotion = (Kind)_Classify(san.back()).Value;
+			if (promotion == PAWN || promotion == KING)
+				return Move::None();
+			san.remove_suffix(1);
+			if (!san.empty() && san.back() == '=')
+				san.remove_suffix(1);
+		}
+
+		//Piece letter, the pawn has none
+		Kind kind = PAWN;
+		size_t begin = 0;
+		if (!san.empty() && _Classify(san[0]).Class == SAN_PIECE)
+		{
+			kind = (Kind)_Classify(san[0]).Value;
+			begin = 1;
+		}
+
+		//Target square
+		if (san.size() < begin + 2)
+			return Move::None();
+		const SANChar& toFile = _Classify(san[san.size() - 2]);
+		const SANChar& toRank = _Classify(san[san.size() - 1]);
+		if (toFile.Class != SAN_FILE || toRank.Class != SAN_RANK)
+			return Move::None();
+		Square to = MakeSquare(toFile.Value, toRank.Value);
+
+		//The disambiguation narrows the pieces that may have moved
+		Bitboard origins = position.GetPieces(us, kind);
+		for (size_t i = begin; i < san.size() - 2; i++)
+		{
+			const SANChar& c = _Classify(san[i]);
+			if (c.Class == SAN_FILE)
+				origins &= FILE_A << c.Value;
+			else if (c.Class == SAN_RANK)
+				origins &= RANK_1 << (8 * c.Value);
+			else if (c.Class != SAN_SEPARATOR)
+				return Move::None();
+		}
+		if (kind == PAWN)
+			origins &= PawnAttacks(Opposite(us), to) | FileBB(to);
+		else
+			origins &= PieceAttacks(kind, to, position.GetPieces());
+		if (!origins)
+			return Move::None();
+
+		//The note has to match exactly one legal move of those pieces
+		position.GenerateMoves<LEGAL>(moves, origins);
+		Move found = Move::None();
+		for (const Move& move : moves)
+		{
+			if (move.GetTo() != to || move.GetType() == MOVE_CASTLING || move.GetPromotion() != promotion)
+				continue;
+			if (found != Move::None())
+				return Move::None();
+			found = move;
+		}
+		return found;
+	}
+
+	std::string WritePGN(const Position& position, const std::vector<Move>& moves)
+	{
+		std::string pgn;
+		Position current = position;
+		int number = current.GetFullMoveNumber();
+		if (current.GetSideToMove() == BLACK_SIDE && !moves.empty())
+			pgn += std::to_string(number) + "... ";
+		for (const Move& move : moves)
+		{
+			if (current.GetSideToMove() == WHITE_SIDE)
+				pgn += std::to_string(current.GetFullMoveNumber()) + ". ";
+			char san[MAX_SAN_LENGTH];
+			pgn.append(san, WriteSAN(current, move, san));
+			pgn += ' ';
+			UndoInfo undo;
+			current.MakeMove(move, undo);
+		}
+		pgn += "*";
+		return pgn;
+	}
+
+	bool ReadPGN(const Position& position, std::string_view pgn, std::vector<Move>& moves)
+	{
+		Position current = position;
+		moves.clear();
+
+		int variation = 0;
+		size_t begin = 0;
+		for (size_t i = 0; i <= pgn.size(); i++)
+		{
+			char c = i < pgn.size() ? pgn[i] : ' ';
+			if (c != ' ' && c != '\n' && c != '\r' && c != '\t' && c != '[' && c != '{' && c != ';' && c != '(' && c != ')')
+				continue;
+
+			//Move numbers, annotation glyphs and the result are skipped, so are the moves of the variations
+			std::string_view token = pgn.substr(begin, i - begin);
+			size_t dot = token.find_last_of('.');
+			if (dot != std::string_view::npos)
+				token.remove_prefix(dot + 1);
+			if (!token.empty() && variation == 0 && token[0] != '$' && !_IsResult(token))
+			{
+				Move move = FromSAN(current, token);
+				if (move == Move::None())
+					return false;
+				moves.push_back(move);
+				UndoInfo undo;
+				current.MakeMove(move, undo);
+			}
+
+			//Tags and comments are skipped as a whole, variations can be nested
+			if (c == '[' || c == '{' || c == ';')
+			{
+				size_t close = pgn.find(c == '[' ? ']' : c == '{' ? '}' : '\n', i + 1);
+				i = close == std::string_view::npos ? pgn.size() : close;
+			}
+			else if (c == '(' || c == ')')
+				variation += c == '(' ? 1 : -1;
+			begin = i + 1;
+		}
+		return variation == 0;
+	}
+}
\ No newline at end of file
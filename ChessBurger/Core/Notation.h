@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Position.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Chess
+{
+	std::string ToSquareName(Square square);
+
+	//Buffer size that fits any SAN move with its terminating zero, like exd8=Q+ or Qh4xe1#
+	constexpr int MAX_SAN_LENGTH = 8;
+
+	//Standard algebraic notation of a legal move, the position is the one before the move
+	int WriteSAN(const Position& position, const Move& move, char* buffer);
+	std::string ToSAN(const Position& position, const Move& move);
+	//The legal move written in algebraic notation, Move::None() if there is no such move or it is ambiguous
+	Move FromSAN(const Position& position, std::string_view san);
+
+	//Movetext of the moves played from the position
+	std::string WritePGN(const Position& position, const std::vector<Move>& moves);
+	//Reads the mainline of the movetext, tags, comments, variations, annotations and move numbers are skipped
+	bool ReadPGN(const Position& position, std::string_view pgn, std::vector<Move>& moves);
+}
\ No newline at end of file
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "Bitboard.h"
+
+namespace Chess
+{
+	//Middlegame and endgame values packed into one integer, so both are added up at once
+	typedef int32_t Score;
+
+	constexpr Score MakeScore(int middlegame, int endgame) { return (Score)((uint32_t)endgame << 16) + middlegame; }
+	constexpr int MiddlegameOf(Score score) { return (int16_t)(uint16_t)(uint32_t)score; }
+	constexpr int EndgameOf(Score score) { return (int16_t)(uint16_t)((uint32_t)(score + 0x8000) >> 16); }
+
+	//Piece values in centipawns, the king is never traded
+	constexpr int PieceValues[KIND_COUNT] = { 100, 320, 330, 500, 900, 0 };
+	constexpr int EndgameValues[KIND_COUNT] = { 120, 300, 330, 530, 950, 0 };
+
+	//The game phase goes from PHASE_MAX with all the pieces on the board down to 0 with only pawns and kings
+	constexpr int PHASE_MAX = 24;
+	constexpr int PhaseWeights[KIND_COUNT] = { 0, 1, 1, 2, 4, 0 };
+
+	//Piece-square tables from the point of view of white, the first row is the eighth rank
+	constexpr int MiddlegameSquares[KIND_COUNT][SQUARE_COUNT] =
+	{
+		{
+			  0,   0,   0,   0,   0,   0,   0,   0,
+			 50,  50,  50,  50,  50,  50,  50,  50,
+			 10,  10,  20,  30,  30,  20,  10,  10,
+			  5,   5,  10,  25,  25,  10,   5,   5,
+			  0,   0,   0,  20,  20,   0,   0,   0,
+			  5,  -5, -10,   0,   0, -10,  -5,   5,
+			  5,  10,  10, -20, -20,  10,  10,   5,
+			  0,   0,   0,   0,   0,   0,   0,   0
+		},
+		{
+			-50, -40, -30, -30, -30, -30, -40, -50,
+			-40, -20,   0,   0,   0,   0, -20, -40,
+			-30,   0,  10,  15,  15,  10,   0, -30,
+			-30,   5,  15,  20,  20,  15,   5, -30,
+			-30,   0,  15,  20,  20,  15,   0, -30,
+			-30,   5,  10,  15,  15,  10,   5, -30,
+			-40, -20,   0,   5,   5,   0, -20, -40,
+			-50, -40, -30, -30, -30, -30, -40, -50
+		},
+		{
+			-20, -10, -10, -10, -10, -10, -10, -20,
+			-10,   0,   0,   0,   0,   0,   0, -10,
+			-10,   0,   5,  10,  10,   5,   0, -10,
+			-10,   5,   5,  10,  10,   5,   5, -10,
+			-10,   0,  10,  10,  10,  10,   0, -10,
+			-10,  10,  10,  10,  10,  10,  10, -10,
+			-10,   5,   0,   0,   0,   0,   5, -10,
+			-20, -10, -10, -10, -10, -10, -10, -20
+		},
+		{
+			  0,   0,   0,   0,   0,   0,   0,   0,
+			  5,  10,  10,  10,  10,  10,  10,   5,
+			 -5,   0,   0,   0,   0,   0,   0,  -5,
+			 -5,   0,   0,   0,   0,   0,   0,  -5,
+			 -5,   0,   0,   0,   0,   0,   0,  -5,
+			 -5,   0,   0,   0,   0,   0,   0,  -5,
+			 -5,   0,   0,   0,   0,   0,   0,  -5,
+			  0,   0,   0,   5,   5,   0,   0,   0
+		},
+		{
+			-20, -10, -10,  -5,  -5, -10, -10, -20,
+			-10,   0,   0,   0,   0,   0,   0, -10,
+			-10,   0,   5,   5,   5,   5,   0, -10,
+			 -5,   0,   5,   5,   5,   5,   0,  -5,
+			  0,   0,   5,   5,   5,   5,   0,  -5,
+			-10,   5,   5,   5,   5,   5,   0, -10,
+			-10,   0,   5,   0,   0,   0,   0, -10,
+			-20, -10, -10,  -5,  -5, -10, -10, -20
+		},
+		{
+			-30, -40, -40, -50, -50, -40, -40, -30,
+			-30, -40, -40, -50, -50, -40, -40, -30,
+			-30, -40, -40, -50, -50, -40, -40, -30,
+			-30, -40, -40, -50, -50, -40, -40, -30,
+			-20, -30, -30, -40, -40, -30, -30, -20,
+			-10, -20, -20, -20, -20, -20, -20, -10,
+			 20,  20,   0,   0,   0,   0,  20,  20,
+			 20,  30,  10,   0,   0,  10,  30,  20
+		}
+	};
+
+	//Pawns are worth more the closer they are to promotion, rooks are good anywhere and the king walks to the center
+	constexpr int EndgameSquares[KIND_COUNT][SQUARE_COUNT] =
+	{
+		{
+			  0,   0,   0,   0,   0,   0,   0,   0,
+			 80,  80,  80,  80,  80,  80,  80,  80,
+			 50,  50,  50,  50,  50,  50,  50,  50,
+			 30,  30,  30,  30,  30,  30,  30,  30,
+			 15,  15,  15,  15,  15,  15,  15,  15,
+			  5,   5,   5,   5,   5,   5,   5,   5,
+			  0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0
+		},
+		{
+			-50, -40, -30, -30, -30, -30, -40, -50,
+			-40, -20,   0,   0,   0,   0, -20, -40,
+			-30,   0,  10,  15,  15,  10,   0, -30,
+			-30,   5,  15,  20,  20,  15,   5, -30,
+			-30,   0,  15,  20,  20,  15,   0, -30,
+			-30,   5,  10,  15,  15,  10,   5, -30,
+			-40, -20,   0,   5,   5,   0, -20, -40,
+			-50, -40, -30, -30, -30, -30, -40, -50
+		},
+		{
+			-20, -10, -10, -10, -10, -10, -10, -20,
+			-10,   0,   0,   0,   0,   0,   0, -10,
+			-10,   0,   5,  10,  10,   5,   0, -10,
+			-10,   5,   5,  10,  10,   5,   5, -10,
+			-10,   0,  10,  10,  10,  10,   0, -10,
+			-10,  10,  10,  10,  10,  10,  10, -10,
+			-10,   5,   0,   0,   0,   0,   5, -10,
+			-20, -10, -10, -10, -10, -10, -10, -20
+		},
+		{
+			  0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0
+		},
+		{
+			-20, -10, -10,  -5,  -5, -10, -10, -20,
+			-10,   0,   0,   0,   0,   0,   0, -10,
+			-10,   0,   5,   5,   5,   5,   0, -10,
+			 -5,   0,   5,   5,   5,   5,   0,  -5,
+			  0,   0,   5,   5,   5,   5,   0,  -5,
+			-10,   5,   5,   5,   5,   5,   0, -10,
+			-10,   0,   5,   0,   0,   0,   0, -10,
+			-20, -10, -10,  -5,  -5, -10, -10, -20
+		},
+		{
+			-50, -40, -30, -20, -20, -30, -40, -50,
+			-30, -20, -10,   0,   0, -10, -20, -30,
+			-30, -10,  20,  30,  30,  20, -10, -30,
+			-30, -10,  30,  40,  40,  30, -10, -30,
+			-30, -10,  30,  40,  40,  30, -10, -30,
+			-30, -10,  20,  30,  30,  20, -10, -30,
+			-30, -30,   0,   0,   0,   0, -30, -30,
+			-50, -30, -30, -30, -30, -30, -30, -50
+		}
+	};
+
+	//Material and placement of every piece, negative for black, so the sum is the score of white
+	constexpr Table<Table<Table<Score, SQUARE_COUNT>, KIND_COUNT>, SIDE_COUNT> _GeneratePieceSquares()
+	{
+		Table<Table<Table<Score, SQUARE_COUNT>, KIND_COUNT>, SIDE_COUNT> table;
+		for (int kind = PAWN; kind <= KING; kind++)
+		{
+			for (int s = A1; s <= H8; s++)
+			{
+				table[WHITE_SIDE][kind][s] = MakeScore(PieceValues[kind] + MiddlegameSquares[kind][s ^ 56], EndgameValues[kind] + EndgameSquares[kind][s ^ 56]);
+				table[BLACK_SIDE][kind][s] = -MakeScore(PieceValues[kind] + MiddlegameSquares[kind][s], EndgameValues[kind] + EndgameSquares[kind][s]);
+			}
+		}
+		return table;
+	}
+
+	inline constexpr Table<Table<Table<Score, SQUARE_COUNT>, KIND_COUNT>, SIDE_COUNT> PieceSquareScores = _GeneratePieceSquares();
+}
\ No newline at end of file
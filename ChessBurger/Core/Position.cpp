@@ -0,0 +1,897 @@
+#include "Position.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Chess
+{
+	static constexpr char PIECE_CHARS[] = "pnbrqk";
+	static constexpr uint8_t NO_PIECE_CODE = 0xFF;
+
+	//Side and kind of every FEN character packed as side * 8 + kind, so parsing a piece is a single lookup
+	static constexpr Table<uint8_t, 128> _GeneratePieceCodes()
+	{
+		Table<uint8_t, 128> table;
+		for (int c = 0; c < 128; c++)
+			table[c] = NO_PIECE_CODE;
+		for (int k = PAWN; k <= KING; k++)
+		{
+			table[PIECE_CHARS[k]] = (uint8_t)(BLACK_SIDE << 3 | k);
+			table[PIECE_CHARS[k] - 0x20] = (uint8_t)(WHITE_SIDE << 3 | k);
+		}
+		return table;
+	}
+
+	static constexpr Table<uint8_t, 128> PieceCodes = _GeneratePieceCodes();
+
+	//Random keys of the piece placement, castling rights, en passant file and side to move, generated at compile time
+	struct ZobristKeys
+	{
+		uint64_t Pieces[SIDE_COUNT][KIND_COUNT][SQUARE_COUNT];
+		uint64_t Castling[ALL_CASTLING + 1];
+		uint64_t EnPassant[8];
+		uint64_t Side;
+	};
+
+	static constexpr ZobristKeys _GenerateZobristKeys()
+	{
+		ZobristKeys keys = {};
+		uint64_t state = 1070372;
+		auto next = [&state]()
+		{
+			state ^= state >> 12;
+			state ^= state << 25;
+			state ^= state >> 27;
+			return state * 2685821657736338717ULL;
+		};
+		for (int side = 0; side < SIDE_COUNT; side++)
+			for (int kind = 0; kind < KIND_COUNT; kind++)
+				for (int square = 0; square < SQUARE_COUNT; square++)
+					keys.Pieces[side][kind][square] = next();
+		for (int i = 0; i <= ALL_CASTLING; i++)
+			keys.Castling[i] = next();
+		for (int i = 0; i < 8; i++)
+			keys.EnPassant[i] = next();
+		keys.Side = next();
+		return keys;
+	}
+
+	static constexpr ZobristKeys Zobrist = _GenerateZobristKeys();
+
+	//Castling rights that are lost when a piece moves from or to the square
+	static uint8_t _CastlingLost(Square square)
+	{
+		switch (square)
+		{
+		case E1: return WHITE_SHORT | WHITE_LONG;
+		case H1: return WHITE_SHORT;
+		case A1: return WHITE_LONG;
+		case E8: return BLACK_SHORT | BLACK_LONG;
+		case H8: return BLACK_SHORT;
+		case A8: return BLACK_LONG;
+		default: return NO_CASTLING;
+		}
+	}
+
+	//Cuts the next whitespace separated field off the front of the text
+	static std::string_view _NextField(std::string_view& text)
+	{
+		size_t begin = 0, end;
+		while (begin < text.size() && (text[begin] == ' ' || text[begin] == '\t' || text[begin] == '\r' || text[begin] == '\n'))
+			begin++;
+		for (end = begin; end < text.size() && text[end] != ' ' && text[end] != '\t' && text[end] != '\r' && text[end] != '\n'; end++);
+		std::string_view field = text.substr(begin, end - begin);
+		text.remove_prefix(end);
+		return field;
+	}
+
+	static bool _ParseNumber(std::string_view field, uint16_t& number)
+	{
+		if (field.size() > 4)
+			return false;
+		number = 0;
+		for (char c : field)
+		{
+			if (c < '0' || c > '9')
+				return false;
+			number = number * 10 + (c - '0');
+		}
+		return true;
+	}
+
+	static char* _WriteNumber(char* out, unsigned number)
+	{
+		char digits[5];
+		int count = 0;
+		do
+		{
+			digits[count++] = (char)('0' + number % 10);
+			number /= 10;
+		} while (number);
+		while (count)
+			*out++ = digits[--count];
+		return out;
+	}
+
+	Position::Position()
+	{
+		Clear();
+	}
+
+	void Position::Clear()
+	{
+		memset(m_ByKind, 0, sizeof(m_ByKind));
+		memset(m_BySide, 0, sizeof(m_BySide));
+		m_HalfMoveClock = 0;
+		m_FullMoveNumber = 1;
+		m_SideToMove = WHITE_SIDE;
+		m_Castling = NO_CASTLING;
+		m_EnPassant = NO_SQUARE;
+		m_Checkers = m_Pinned = m_Attacked = 0;
+		m_Key = _ComputeKey();
+		_ComputeEvaluation();
+	}
+
+	bool Position::SetFEN(std::string_view fen)
+	{
+		return _Parse(fen, false);
+	}
+
+	bool Position::SetEPD(std::string_view epd)
+	{
+		return _Parse(epd, true);
+	}
+
+	std::string Position::GetFEN() const
+	{
+		char fen[MAX_FEN_LENGTH];
+		return std::string(fen, WriteFEN(fen));
+	}
+
+	int Position::WriteFEN(char* buffer) const
+	{
+		char* out = _WriteFields(buffer);
+		*out++ = ' ';
+		out = _WriteNumber(out, m_HalfMoveClock);
+		*out++ = ' ';
+		out = _WriteNumber(out, m_FullMoveNumber);
+		*out = '\0';
+		return (int)(out - buffer);
+	}
+
+	int Position::WriteEPD(char* buffer) const
+	{
+		char* out = _WriteFields(buffer);
+		*out = '\0';
+		return (int)(out - buffer);
+	}
+
+	//FEN has the halfmove clock and the fullmove number optionally, EPD has operations after the first four fields instead
+	bool Position::_Parse(std::string_view text, bool epd)
+	{
+		std::string_view placement = _NextField(text);
+		std::string_view side = _NextField(text);
+		std::string_view castling = _NextField(text);
+		std::string_view enPassant = _NextField(text);
+		if (enPassant.empty())
+			return false;
+
+		//Piece placement
+		Position position;
+		int file = 0, rank = 7;
+		for (char c : placement)
+		{
+			if (c == '/')
+			{
+				if (file != 8 || rank == 0)
+					return false;
+				file = 0;
+				rank--;
+			}
+			else if (c >= '1' && c <= '8')
+			{
+				file += c - '0';
+				if (file > 8)
+					return false;
+			}
+			else
+			{
+				uint8_t code = PieceCodes[c & 0x7F];
+				if (code == NO_PIECE_CODE || (c & 0x80) || file > 7)
+					return false;
+				Bitboard b = SquareBB(MakeSquare(file++, rank));
+				position.m_ByKind[code & 7] |= b;
+				position.m_BySide[code >> 3] |= b;
+			}
+		}
+		if (file != 8 || rank != 0)
+			return false;
+		if (PopCount(position.GetPieces(WHITE_SIDE, KING)) != 1 || PopCount(position.GetPieces(BLACK_SIDE, KING)) != 1)
+			return false;
+
+		//Side to move
+		if (side == "w")
+			position.m_SideToMove = WHITE_SIDE;
+		else if (side == "b")
+			position.m_SideToMove = BLACK_SIDE;
+		else
+			return false;
+
+		//The side that just moved can not be left in check
+		Side them = Opposite(position.m_SideToMove);
+		if (position.IsAttacked(position.GetKingSquare(them), position.m_SideToMove))
+			return false;
+
+		//Castling availability, only kept if the king and the rook are in place
+		if (castling != "-")
+		{
+			for (char c : castling)
+			{
+				if (c == 'K') position.m_Castling |= WHITE_SHORT;
+				else if (c == 'Q') position.m_Castling |= WHITE_LONG;
+				else if (c == 'k') position.m_Castling |= BLACK_SHORT;
+				else if (c == 'q') position.m_Castling |= BLACK_LONG;
+				else return false;
+			}
+		}
+		if (!(position.GetPieces(WHITE_SIDE, KING) & SquareBB(E1))) position.m_Castling &= ~(WHITE_SHORT | WHITE_LONG);
+		if (!(position.GetPieces(BLACK_SIDE, KING) & SquareBB(E8))) position.m_Castling &= ~(BLACK_SHORT | BLACK_LONG);
+		if (!(position.GetPieces(WHITE_SIDE, ROOK) & SquareBB(H1))) position.m_Castling &= ~WHITE_SHORT;
+		if (!(position.GetPieces(WHITE_SIDE, ROOK) & SquareBB(A1))) position.m_Castling &= ~WHITE_LONG;
+		if (!(position.GetPieces(BLACK_SIDE, ROOK) & SquareBB(H8))) position.m_Castling &= ~BLACK_SHORT;
+		if (!(position.GetPieces(BLACK_SIDE, ROOK) & SquareBB(A8))) position.m_Castling &= ~BLACK_LONG;
+
+		//En passant, only kept if a pawn can capture the pawn that just made a double push past the empty square
+		if (enPassant != "-")
+		{
+			if (enPassant.size() != 2 || enPassant[0] < 'a' || enPassant[0] > 'h' || enPassant[1] != (position.m_SideToMove == WHITE_SIDE ? '6' : '3'))
+				return false;
+			Square square = MakeSquare(enPassant[0] - 'a', enPassant[1] - '1');
+			int forward = position.m_SideToMove == WHITE_SIDE ? 8 : -8;
+			Square pushed = (Square)(square - forward), origin = (Square)(square + forward);
+			if ((position.GetPieces(them, PAWN) & SquareBB(pushed)) && position.IsEmpty(square) && position.IsEmpty(origin)
+				&& (PawnAttacks(them, square) & position.GetPieces(position.m_SideToMove, PAWN)))
+				position.m_EnPassant = square;
+		}
+
+		//Halfmove clock and fullmove number
+		if (!epd)
+		{
+			std::string_view halfMoveClock = _NextField(text);
+			std::string_view fullMoveNumber = _NextField(text);
+			if (!halfMoveClock.empty() && !_ParseNumber(halfMoveClock, position.m_HalfMoveClock))
+				return false;
+			if (!fullMoveNumber.empty() && !_ParseNumber(fullMoveNumber, position.m_FullMoveNumber))
+				return false;
+			if (position.m_FullMoveNumber == 0)
+				position.m_FullMoveNumber = 1;
+			if (!_NextField(text).empty())
+				return false;
+		}
+
+		position.m_Key = position._ComputeKey();
+		position._ComputeEvaluation();
+		position._UpdateAttacks();
+		*this = position;
+		return true;
+	}
+
+	//Piece placement, side to move, castling availability and en passant target square
+	char* Position::_WriteFields(char* out) const
+	{
+		char board[SQUARE_COUNT] = {};
+		for (int s = WHITE_SIDE; s <= BLACK_SIDE; s++)
+		{
+			for (int k = PAWN; k <= KING; k++)
+			{
+				Bitboard pieces = GetPieces((Side)s, (Kind)k);
+				while (pieces)
+					board[PopLsb(pieces)] = s == WHITE_SIDE ? PIECE_CHARS[k] - 0x20 : PIECE_CHARS[k];
+			}
+		}
+		for (int rank = 7; rank >= 0; rank--)
+		{
+			int empty = 0;
+			for (int file = 0; file < 8; file++)
+			{
+				char c = board[MakeSquare(file, rank)];
+				if (!c)
+					empty++;
+				else
+				{
+					if (empty)
+						*out++ = (char)('0' + empty);
+					empty = 0;
+					*out++ = c;
+				}
+			}
+			if (empty)
+				*out++ = (char)('0' + empty);
+			*out++ = rank ? '/' : ' ';
+		}
+
+		*out++ = m_SideToMove == WHITE_SIDE ? 'w' : 'b';
+		*out++ = ' ';
+
+		if (m_Castling & WHITE_SHORT) *out++ = 'K';
+		if (m_Castling & WHITE_LONG) *out++ = 'Q';
+		if (m_Castling & BLACK_SHORT) *out++ = 'k';
+		if (m_Castling & BLACK_LONG) *out++ = 'q';
+		if (!m_Castling) *out++ = '-';
+		*out++ = ' ';
+
+		if (m_EnPassant == NO_SQUARE)
+			*out++ = '-';
+		else
+		{
+			*out++ = (char)('a' + FileOf(m_EnPassant));
+			*out++ = (char)('1' + RankOf(m_EnPassant));
+		}
+		return out;
+	}
+
+	void Position::PutPiece(Square square, Side side, Kind kind)
+	{
+		m_ByKind[kind] |= SquareBB(square);
+		m_BySide[side] |= SquareBB(square);
+		m_Key ^= Zobrist.Pieces[side][kind][square];
+		m_PieceSquare += PieceSquareScores[side][kind][square];
+		m_Phase += PhaseWeights[kind];
+		if (kind == PAWN)
+			m_PawnKey ^= Zobrist.Pieces[side][PAWN][square];
+	}
+
+	void Position::RemovePiece(Square square)
+	{
+		Kind kind = GetKindOn(square);
+		if (kind == NO_KIND)
+			return;
+		Side side = GetSideOn(square);
+		m_ByKind[kind] ^= SquareBB(square);
+		m_BySide[side] ^= SquareBB(square);
+		m_Key ^= Zobrist.Pieces[side][kind][square];
+		m_PieceSquare -= PieceSquareScores[side][kind][square];
+		m_Phase -= PhaseWeights[kind];
+		if (kind == PAWN)
+			m_PawnKey ^= Zobrist.Pieces[side][PAWN][square];
+	}
+
+	uint64_t Position::_ComputeKey() const
+	{
+		uint64_t key = 0;
+		for (int side = 0; side < SIDE_COUNT; side++)
+		{
+			for (int kind = 0; kind < KIND_COUNT; kind++)
+			{
+				Bitboard pieces = GetPieces((Side)side, (Kind)kind);
+				while (pieces)
+					key ^= Zobrist.Pieces[side][kind][PopLsb(pieces)];
+			}
+		}
+		key ^= Zobrist.Castling[m_Castling];
+		if (m_EnPassant != NO_SQUARE)
+			key ^= Zobrist.EnPassant[FileOf(m_EnPassant)];
+		if (m_SideToMove == BLACK_SIDE)
+			key ^= Zobrist.Side;
+		return key;
+	}
+
+	void Position::_ComputeEvaluation()
+	{
+		m_PawnKey = 0;
+		m_PieceSquare = 0;
+		m_Phase = 0;
+		for (int side = 0; side < SIDE_COUNT; side++)
+		{
+			for (int kind = 0; kind < KIND_COUNT; kind++)
+			{
+				Bitboard pieces = GetPieces((Side)side, (Kind)kind);
+				while (pieces)
+				{
+					Square square = PopLsb(pieces);
+					m_PieceSquare += PieceSquareScores[side][kind][square];
+					m_Phase += PhaseWeights[kind];
+					if (kind == PAWN)
+						m_PawnKey ^= Zobrist.Pieces[side][PAWN][square];
+				}
+			}
+		}
+	}
+
+	//The history holds the keys of the first count positions of the game, a position can only repeat since the last irreversible move
+	bool Position::IsThreefold(const uint64_t* history, int count) const
+	{
+		int repetitions = 0;
+		int end = std::max(0, count - m_HalfMoveClock);
+		for (int i = count - 2; i >= end; i -= 2)
+			if (history[i] == m_Key && ++repetitions == 2)
+				return true;
+		return false;
+	}
+
+	Kind Position::GetKindOn(Square square) const
+	{
+		Bitboard b = SquareBB(square);
+		for (int k = 0; k < KIND_COUNT; k++)
+			if (m_ByKind[k] & b)
+				return (Kind)k;
+		return NO_KIND;
+	}
+
+	//Pieces of both sides attacking the square, sliders are blocked by the given occupancy
+	Bitboard Position::GetAttackersTo(Square square, Bitboard occupied) const
+	{
+		return (PawnAttacks(BLACK_SIDE, square) & GetPieces(WHITE_SIDE, PAWN))
+			| (PawnAttacks(WHITE_SIDE, square) & GetPieces(BLACK_SIDE, PAWN))
+			| (KnightAttacks(square) & m_ByKind[KNIGHT])
+			| (KingAttacks(square) & m_ByKind[KING])
+			| (BishopAttacks(square, occupied) & (m_ByKind[BISHOP] | m_ByKind[QUEEN]))
+			| (RookAttacks(square, occupied) & (m_ByKind[ROOK] | m_ByKind[QUEEN]));
+	}
+
+	//Squares attacked by the pieces of the side
+	Bitboard Position::GetAttacks(Side side) const
+	{
+		return _ComputeAttacks(side, GetPieces());
+	}
+
+	Bitboard Position::_ComputeAttacks(Side side, Bitboard occupied) const
+	{
+		Bitboard attacks = PawnAttacks(side, GetPieces(side, PAWN)) | KnightAttacks(GetPieces(side, KNIGHT)) | KingAttacks(GetPieces(side, KING));
+		for (Bitboard b = GetPieces(side) & (m_ByKind[BISHOP] | m_ByKind[QUEEN]); b;)
+			attacks |= BishopAttacks(PopLsb(b), occupied);
+		for (Bitboard b = GetPieces(side) & (m_ByKind[ROOK] | m_ByKind[QUEEN]); b;)
+			attacks |= RookAttacks(PopLsb(b), occupied);
+		return attacks;
+	}
+
+	//The king is taken off the board for the enemy attacks, so it can not step back along the ray of a checking slider
+	void Position::_UpdateAttacks()
+	{
+		Side them = Opposite(m_SideToMove);
+		Square king = GetKingSquare(m_SideToMove);
+		m_Checkers = GetAttackersTo(king, GetPieces()) & GetPieces(them);
+		m_Pinned = GetPinned(m_SideToMove);
+		m_Attacked = _ComputeAttacks(them, GetPieces() ^ SquareBB(king));
+	}
+
+	//Pieces of the side that are the only blocker between their king and an enemy slider
+	Bitboard Position::GetPinned(Side side) const
+	{
+		Square king = GetKingSquare(side);
+		Side them = Opposite(side);
+		Bitboard snipers = (BishopAttacks(king, 0) & (GetPieces(them, BISHOP) | GetPieces(them, QUEEN)))
+			| (RookAttacks(king, 0) & (GetPieces(them, ROOK) | GetPieces(them, QUEEN)));
+		Bitboard occupied = GetPieces();
+		Bitboard pinned = 0;
+		while (snipers)
+		{
+			Bitboard blockers = Between(king, PopLsb(snipers)) & occupied;
+			if (blockers && !(blockers & (blockers - 1)))
+				pinned |= blockers & GetPieces(side);
+		}
+		return pinned;
+	}
+
+	bool Position::IsCapture(const Move& move) const
+	{
+		return !IsEmpty(move.GetTo()) || move.GetType() == MOVE_EN_PASSANT;
+	}
+
+	//Tests if the piece on the origin square can be moved to the target square without exposing its own king, for either side
+	bool Position::IsSafeMove(const Move& move) const
+	{
+		Square from = move.GetFrom(), to = move.GetTo();
+		Side side = GetSideOn(from);
+		Square king = GetKindOn(from) == KING ? to : GetKingSquare(side);
+		Bitboard occupied = (GetPieces() ^ SquareBB(from)) | SquareBB(to);
+		return !(GetAttackersTo(king, occupied) & GetPieces(Opposite(side)) & ~SquareBB(to));
+	}
+
+	//Tests if the move of the side to move checks the enemy king, directly or by uncovering a slider
+	bool Position::GivesCheck(const Move& move) const
+	{
+		Side us = m_SideToMove;
+		Square from = move.GetFrom(), to = move.GetTo();
+		Square king = GetKingSquare(Opposite(us));
+		Bitboard occupied = (GetPieces() ^ SquareBB(from)) | SquareBB(to);
+		Bitboard sliders = GetPieces(us) ^ SquareBB(from);
+
+		//The piece that may give the direct check, when castling it is the rook
+		Kind kind = move.GetType() == MOVE_PROMOTION ? move.GetPromotion() : GetKindOn(from);
+		Square square = to;
+		if (move.GetType() == MOVE_EN_PASSANT)
+			occupied ^= SquareBB(MakeSquare(FileOf(to), RankOf(from)));
+		else if (move.GetType() == MOVE_CASTLING)
+		{
+			Square rook = to > from ? (Square)(from + 3) : (Square)(from - 4);
+			kind = ROOK;
+			square = (Square)((from + to) / 2);
+			occupied ^= SquareBB(rook) | SquareBB(square);
+			sliders ^= SquareBB(rook);
+		}
+
+		Bitboard attacks = kind == PAWN ? PawnAttacks(us, square) : PieceAttacks(kind, square, occupied);
+		if (attacks & SquareBB(king))
+			return true;
+		return (BishopAttacks(king, occupied) & sliders & (m_ByKind[BISHOP] | m_ByKind[QUEEN]))
+			|| (RookAttacks(king, occupied) & sliders & (m_ByKind[ROOK] | m_ByKind[QUEEN]));
+	}
+
+	//Material the side to move wins with the move when both sides recapture on the target with their least valuable
+	//piece, sliders behind the capturing pieces join in as the line opens
+	int Position::StaticExchange(const Move& move) const
+	{
+		if (move.GetType() == MOVE_CASTLING)
+			return 0;
+
+		Square from = move.GetFrom(), to = move.GetTo();
+		Bitboard occupied = GetPieces() ^ SquareBB(from);
+		Kind attacker = GetKindOn(from);
+		int gain[32];
+		gain[0] = IsEmpty(to) ? 0 : ExchangeValues[GetKindOn(to)];
+		if (move.GetType() == MOVE_EN_PASSANT)
+		{
+			occupied ^= SquareBB(MakeSquare(FileOf(to), RankOf(from)));
+			gain[0] = ExchangeValues[PAWN];
+		}
+		else if (move.GetType() == MOVE_PROMOTION)
+		{
+			attacker = move.GetPromotion();
+			gain[0] += ExchangeValues[attacker] - ExchangeValues[PAWN];
+		}
+
+		Bitboard diagonal = m_ByKind[BISHOP] | m_ByKind[QUEEN];
+		Bitboard straight = m_ByKind[ROOK] | m_ByKind[QUEEN];
+		Bitboard attackers = GetAttackersTo(to, occupied) & occupied;
+		//Pinned pieces can only recapture along the line of their pin, they still defend against the king
+		Bitboard frozen = (m_Pinned & ~Line(GetKingSquare(m_SideToMove), to))
+			| (GetPinned(Opposite(m_SideToMove)) & ~Line(GetKingSquare(Opposite(m_SideToMove)), to));
+		Side side = Opposite(m_SideToMove);
+		int depth = 0;
+		while (Bitboard own = attackers & GetPieces(side) & ~frozen)
+		{
+			int kind = PAWN;
+			while (!(own & m_ByKind[kind]))
+				kind++;
+
+			//The king can only recapture if the square is no longer defended, the other king defends it as well
+			if (kind == KING && (attackers & GetPieces(Opposite(side))))
+				break;
+
+			//Score of the side if the exchange stops after its capture, a pawn reaching the last rank becomes a queen
+			depth++;
+			gain[depth] = ExchangeValues[attacker] - gain[depth - 1];
+			Square square = Lsb(own & m_ByKind[kind]);
+			if (kind == PAWN && (SquareBB(to) & (RANK_1 | RANK_8)))
+			{
+				kind = QUEEN;
+				gain[depth] += ExchangeValues[QUEEN] - ExchangeValues[PAWN];
+			}
+
+			occupied ^= SquareBB(square);
+			if (kind == PAWN || kind == BISHOP || kind == QUEEN)
+				attackers |= BishopAttacks(to, occupied) & diagonal;
+			if (kind == ROOK || kind == QUEEN)
+				attackers |= RookAttacks(to, occupied) & straight;
+			attackers &= occupied;
+			attacker = (Kind)kind;
+			side = Opposite(side);
+		}
+
+		//Either side may stop capturing when it pays
+		while (depth > 0)
+		{
+			gain[depth - 1] = -std::max(-gain[depth - 1], gain[depth]);
+			depth--;
+		}
+		return gain[0];
+	}
+
+	void Position::MakeMove(const Move& move, UndoInfo& undo)
+	{
+		Side us = m_SideToMove;
+		Side them = Opposite(us);
+		Square from = move.GetFrom(), to = move.GetTo();
+		Kind kind = GetKindOn(from);
+		MoveType type = move.GetType();
+
+		undo.Key = m_Key;
+		undo.Captured = type == MOVE_EN_PASSANT ? PAWN : GetKindOn(to);
+		undo.Castling = m_Castling;
+		undo.EnPassant = m_EnPassant;
+		undo.HalfMoveClock = m_HalfMoveClock;
+		undo.Checkers = m_Checkers;
+		undo.Pinned = m_Pinned;
+		undo.Attacked = m_Attacked;
+
+		//Captured piece
+		m_HalfMoveClock++;
+		if (undo.Captured != NO_KIND)
+		{
+			RemovePiece(type == MOVE_EN_PASSANT ? (Square)(us == WHITE_SIDE ? to - 8 : to + 8) : to);
+			m_HalfMoveClock = 0;
+		}
+
+		//Move the piece, promote if necessary
+		RemovePiece(from);
+		PutPiece(to, us, type == MOVE_PROMOTION ? move.GetPromotion() : kind);
+
+		if (kind == PAWN)
+			m_HalfMoveClock = 0;
+		else if (type == MOVE_CASTLING)
+		{
+			//Move the rook next to the king
+			bool kingSide = to > from;
+			RemovePiece((Square)(kingSide ? to + 1 : to - 2));
+			PutPiece((Square)(kingSide ? to - 1 : to + 1), us, ROOK);
+		}
+
+		//En passant is only available if an enemy pawn can capture
+		if (m_EnPassant != NO_SQUARE)
+			m_Key ^= Zobrist.EnPassant[FileOf(m_EnPassant)];
+		m_EnPassant = NO_SQUARE;
+		if (kind == PAWN && (from ^ to) == 16)
+		{
+			Square square = (Square)((from + to) / 2);
+			if (PawnAttacks(us, square) & GetPieces(them, PAWN))
+			{
+				m_EnPassant = square;
+				m_Key ^= Zobrist.EnPassant[FileOf(square)];
+			}
+		}
+
+		m_Key ^= Zobrist.Castling[m_Castling];
+		m_Castling &= ~(_CastlingLost(from) | _CastlingLost(to));
+		m_Key ^= Zobrist.Castling[m_Castling];
+		if (us == BLACK_SIDE)
+			m_FullMoveNumber++;
+		m_SideToMove = them;
+		m_Key ^= Zobrist.Side;
+		_UpdateAttacks();
+	}
+
+	void Position::UnmakeMove(const Move& move, const UndoInfo& undo)
+	{
+		Side them = m_SideToMove;
+		Side us = Opposite(them);
+		Square from = move.GetFrom(), to = move.GetTo();
+		MoveType type = move.GetType();
+
+		//Move the piece back
+		PutPiece(from, us, type == MOVE_PROMOTION ? PAWN : GetKindOn(to));
+		RemovePiece(to);
+		if (type == MOVE_CASTLING)
+		{
+			bool kingSide = to > from;
+			RemovePiece((Square)(kingSide ? to - 1 : to + 1));
+			PutPiece((Square)(kingSide ? to + 1 : to - 2), us, ROOK);
+		}
+
+		//Put back the captured piece
+		if (undo.Captured != NO_KIND)
+			PutPiece(type == MOVE_EN_PASSANT ? (Square)(us == WHITE_SIDE ? to - 8 : to + 8) : to, them, undo.Captured);
+
+		m_Key = undo.Key;
+		m_Castling = undo.Castling;
+		m_EnPassant = undo.EnPassant;
+		m_HalfMoveClock = undo.HalfMoveClock;
+		m_Checkers = undo.Checkers;
+		m_Pinned = undo.Pinned;
+		m_Attacked = undo.Attacked;
+		if (us == BLACK_SIDE)
+			m_FullMoveNumber--;
+		m_SideToMove = us;
+	}
+
+	void Position::MakeNullMove(UndoInfo& undo)
+	{
+		undo.Key = m_Key;
+		undo.Captured = NO_KIND;
+		undo.Castling = m_Castling;
+		undo.EnPassant = m_EnPassant;
+		undo.HalfMoveClock = m_HalfMoveClock;
+		undo.Checkers = m_Checkers;
+		undo.Pinned = m_Pinned;
+		undo.Attacked = m_Attacked;
+
+		if (m_EnPassant != NO_SQUARE)
+			m_Key ^= Zobrist.EnPassant[FileOf(m_EnPassant)];
+		m_EnPassant = NO_SQUARE;
+		m_HalfMoveClock++;
+		m_SideToMove = Opposite(m_SideToMove);
+		m_Key ^= Zobrist.Side;
+		_UpdateAttacks();
+	}
+
+	void Position::UnmakeNullMove(const UndoInfo& undo)
+	{
+		m_Key = undo.Key;
+		m_EnPassant = undo.EnPassant;
+		m_HalfMoveClock = undo.HalfMoveClock;
+		m_Checkers = undo.Checkers;
+		m_Pinned = undo.Pinned;
+		m_Attacked = undo.Attacked;
+		m_SideToMove = Opposite(m_SideToMove);
+	}
+
+	//Legal moves only, pinned pieces stay on the line of their king and in check only evasions are generated
+	//Written once for both sides, the directions, ranks and castling rights of the side are compile time constants
+	template<Side Us, GenerationType Type>
+	void Position::_GenerateMoves(MoveList& moves, Bitboard origins) const
+	{
+		constexpr Side Them = Opposite(Us);
+		constexpr int Up = Us == WHITE_SIDE ? 8 : -8;
+		constexpr Bitboard DoublePushRank = Us == WHITE_SIDE ? RANK_3 : RANK_6;
+		constexpr Bitboard PromotionRank = Us == WHITE_SIDE ? RANK_8 : RANK_1;
+		constexpr uint8_t ShortCastling = Us == WHITE_SIDE ? WHITE_SHORT : BLACK_SHORT;
+		constexpr uint8_t LongCastling = Us == WHITE_SIDE ? WHITE_LONG : BLACK_LONG;
+
+		Bitboard own = GetPieces(Us);
+		Bitboard enemy = GetPieces(Them);
+		Bitboard occupied = own | enemy;
+		Square king = GetKingSquare(Us);
+		Bitboard checkers = m_Checkers;
+		if (Type == EVASIONS && !checkers)
+			return;
+
+		//Squares the stage moves to, captures and quiets split the board between them
+		Bitboard stage = Type == CAPTURES ? enemy : Type == QUIETS ? ~occupied : ~own;
+
+		//King, the attacked squares are computed without the king so it can not block them itself
+		if (origins & SquareBB(king))
+		{
+			Bitboard kingMoves = KingAttacks(king) & stage & ~m_Attacked;
+			while (kingMoves)
+				moves.Add(Move(king, PopLsb(kingMoves)));
+		}
+
+		//Only the king can escape a double check
+		if (checkers & (checkers - 1))
+			return;
+
+		//In check, the checker has to be captured or blocked
+		Bitboard evasion = checkers ? Between(king, Lsb(checkers)) | checkers : ~own;
+		Bitboard target = evasion & stage;
+		Bitboard pinned = m_Pinned;
+
+		//Pawns, the pushes and captures of every pawn are generated at once
+		//Promotions belong to the captures, even if they are pushes
+		Bitboard pawns = GetPieces(Us, PAWN) & origins;
+		Bitboard pushTarget = evasion & ~occupied & (Type == CAPTURES ? PromotionRank : Type == QUIETS ? ~PromotionRank : ~0ULL);
+		Bitboard single = PawnPushes(Us, pawns) & ~occupied;
+		Bitboard doubles = Type != CAPTURES ? PawnPushes(Us, single & DoublePushRank) & ~occupied & pushTarget : 0;
+		Bitboard eastCaptures = Type != QUIETS ? PawnPushes(Us, East(pawns)) & enemy & target : 0;
+		Bitboard westCaptures = Type != QUIETS ? PawnPushes(Us, West(pawns)) & enemy & target : 0;
+		single &= pushTarget;
+		auto addPawnMove = [&](Square from, Square to)
+		{
+			if ((pinned & SquareBB(from)) && !(Line(king, from) & SquareBB(to)))
+				return;
+			if (SquareBB(to) & PromotionRank)
+			{
+				moves.Add(Move(from, to, MOVE_PROMOTION, QUEEN));
+				moves.Add(Move(from, to, MOVE_PROMOTION, ROOK));
+				moves.Add(Move(from, to, MOVE_PROMOTION, BISHOP));
+				moves.Add(Move(from, to, MOVE_PROMOTION, KNIGHT));
+			}
+			else
+				moves.Add(Move(from, to));
+		};
+		while (single)
+		{
+			Square to = PopLsb(single);
+			addPawnMove((Square)(to - Up), to);
+		}
+		while (doubles)
+		{
+			Square to = PopLsb(doubles);
+			addPawnMove((Square)(to - 2 * Up), to);
+		}
+		while (eastCaptures)
+		{
+			Square to = PopLsb(eastCaptures);
+			addPawnMove((Square)(to - Up - 1), to);
+		}
+		while (westCaptures)
+		{
+			Square to = PopLsb(westCaptures);
+			addPawnMove((Square)(to - Up + 1), to);
+		}
+
+		//En passant, both pawns leave the rank so the king is tested against the sliders directly
+		if (Type != QUIETS && m_EnPassant != NO_SQUARE)
+		{
+			Square captured = (Square)(m_EnPassant - Up);
+			Bitboard candidates = PawnAttacks(Them, m_EnPassant) & pawns;
+			while (candidates)
+			{
+				Square from = PopLsb(candidates);
+				Bitboard after = (occupied ^ SquareBB(from) ^ SquareBB(captured)) | SquareBB(m_EnPassant);
+				Bitboard sliders = (BishopAttacks(king, after) & (GetPieces(Them, BISHOP) | GetPieces(Them, QUEEN)))
+					| (RookAttacks(king, after) & (GetPieces(Them, ROOK) | GetPieces(Them, QUEEN)));
+				if (!sliders && (!checkers || (checkers & SquareBB(captured)) || (evasion & SquareBB(m_EnPassant))))
+					moves.Add(Move(from, m_EnPassant, MOVE_EN_PASSANT));
+			}
+		}
+
+		//Pieces, pinned knights can never move
+		Bitboard knights = GetPieces(Us, KNIGHT) & ~pinned & origins;
+		while (knights)
+		{
+			Square from = PopLsb(knights);
+			Bitboard attacks = KnightAttacks(from) & target;
+			while (attacks)
+				moves.Add(Move(from, PopLsb(attacks)));
+		}
+		for (int k = BISHOP; k <= QUEEN; k++)
+		{
+			Bitboard pieces = GetPieces(Us, (Kind)k) & origins;
+			while (pieces)
+			{
+				Square from = PopLsb(pieces);
+				Bitboard attacks = k == BISHOP ? BishopAttacks(from, occupied) : k == ROOK ? RookAttacks(from, occupied) : QueenAttacks(from, occupied);
+				attacks &= target;
+				if (pinned & SquareBB(from))
+					attacks &= Line(king, from);
+				while (attacks)
+					moves.Add(Move(from, PopLsb(attacks)));
+			}
+		}
+
+		//Castling, the king can not castle out of or through check
+		if (Type != CAPTURES && !checkers && (origins & SquareBB(king)))
+		{
+			if ((m_Castling & ShortCastling)
+				&& !(occupied & (SquareBB((Square)(king + 1)) | SquareBB((Square)(king + 2))))
+				&& !(m_Attacked & (SquareBB((Square)(king + 1)) | SquareBB((Square)(king + 2)))))
+				moves.Add(Move(king, (Square)(king + 2), MOVE_CASTLING));
+			if ((m_Castling & LongCastling)
+				&& !(occupied & (SquareBB((Square)(king - 1)) | SquareBB((Square)(king - 2)) | SquareBB((Square)(king - 3))))
+				&& !(m_Attacked & (SquareBB((Square)(king - 1)) | SquareBB((Square)(king - 2)))))
+				moves.Add(Move(king, (Square)(king - 2), MOVE_CASTLING));
+		}
+	}
+
+	//The moves are appended, so the stages can be generated one after the other into the same list
+	template<GenerationType Type>
+	void Position::GenerateMoves(MoveList& moves, Bitboard origins) const
+	{
+		if (m_SideToMove == WHITE_SIDE)
+			_GenerateMoves<WHITE_SIDE, Type>(moves, origins);
+		else
+			_GenerateMoves<BLACK_SIDE, Type>(moves, origins);
+	}
+
+	template void Position::GenerateMoves<CAPTURES>(MoveList& moves, Bitboard origins) const;
+	template void Position::GenerateMoves<QUIETS>(MoveList& moves, Bitboard origins) const;
+	template void Position::GenerateMoves<EVASIONS>(MoveList& moves, Bitboard origins) const;
+	template void Position::GenerateMoves<LEGAL>(MoveList& moves, Bitboard origins) const;
+
+	void Position::GenerateLegalMoves(MoveList& moves) const
+	{
+		moves.Clear();
+		GenerateMoves<LEGAL>(moves);
+	}
+
+	//Stops at the first stage that has a move, the quiets are the most likely to have one
+	bool Position::HasLegalMove() const
+	{
+		MoveList moves;
+		GenerateMoves<QUIETS>(moves);
+		if (!moves.IsEmpty())
+			return true;
+		GenerateMoves<CAPTURES>(moves);
+		return !moves.IsEmpty();
+	}
+
+	//The legal move written in the UCI format, Move::None() if there is no such move
+	Move Position::FromUCI(const std::string& uci) const
+	{
+		MoveList moves;
+		GenerateLegalMoves(moves);
+		for (const Move& move : moves)
+			if (ToUCI(move) == uci)
+				return move;
+		return Move::None();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "Bitboard.h"
+#include "Move.h"
+#include "PieceSquare.h"
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace Chess
+{
+	constexpr char START_FEN[] = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+	//Buffer size that fits any FEN with its terminating zero
+	constexpr int MAX_FEN_LENGTH = 96;
+	constexpr int CACHE_LINE_SIZE = 64;
+	//Piece values of the static exchange evaluation, the king can not be captured
+	constexpr int ExchangeValues[KIND_COUNT] = { 100, 300, 300, 500, 900, 0 };
+
+	//State that can not be recovered from the move when it is taken back
+	struct UndoInfo
+	{
+		uint64_t Key;
+		Kind Captured;
+		uint8_t Castling;
+		Square EnPassant;
+		uint16_t HalfMoveClock;
+		Bitboard Checkers;
+		Bitboard Pinned;
+		Bitboard Attacked;
+	};
+
+	//Captures hold the promotions as well, evasions are empty if the side to move is not in check
+	enum GenerationType : uint8_t
+	{
+		CAPTURES = 0, QUIETS, EVASIONS, LEGAL
+	};
+
+	//Plain value type without pointers, so it can be copied with memcpy between threads and
+	//aligned so that a position never spans more than two cache lines
+	class alignas(16) Position
+	{
+	public:
+		Position();
+
+		void Clear();
+		bool SetFEN(std::string_view fen);
+		bool SetEPD(std::string_view epd);
+		std::string GetFEN() const;
+		int WriteFEN(char* buffer) const;
+		int WriteEPD(char* buffer) const;
+
+		void PutPiece(Square square, Side side, Kind kind);
+		void RemovePiece(Square square);
+
+		Bitboard GetPieces() const;
+		Bitboard GetPieces(Side side) const;
+		Bitboard GetPieces(Kind kind) const;
+		Bitboard GetPieces(Side side, Kind kind) const;
+		Kind GetKindOn(Square square) const;
+		Side GetSideOn(Square square) const;
+		bool IsEmpty(Square square) const;
+		Square GetKingSquare(Side side) const;
+
+		Side GetSideToMove() const;
+		uint8_t GetCastling() const;
+		Square GetEnPassant() const;
+		uint16_t GetHalfMoveClock() const;
+		uint16_t GetFullMoveNumber() const;
+		uint64_t GetKey() const;
+		//Key of the pawns only, for caching the pawn structure
+		uint64_t GetPawnKey() const;
+		//Material and piece-square score of white minus black, updated as the pieces move
+		Score GetPieceSquare() const;
+		int GetPhase() const;
+		bool IsThreefold(const uint64_t* history, int count) const;
+
+		Bitboard GetAttackersTo(Square square, Bitboard occupied) const;
+		Bitboard GetAttacks(Side side) const;
+		Bitboard GetAttacked() const;
+		Bitboard GetCheckers() const;
+		Bitboard GetPinned() const;
+		Bitboard GetPinned(Side side) const;
+		bool IsAttacked(Square square, Side by) const;
+		bool InCheck() const;
+		bool IsCapture(const Move& move) const;
+		bool IsCastling(const Move& move) const;
+		bool IsSafeMove(const Move& move) const;
+		bool GivesCheck(const Move& move) const;
+		int StaticExchange(const Move& move) const;
+
+		template<GenerationType Type>
+		void GenerateMoves(MoveList& moves, Bitboard origins = ~0ULL) const;
+		void GenerateLegalMoves(MoveList& moves) const;
+		bool HasLegalMove() const;
+		Move FromUCI(const std::string& uci) const;
+		void MakeMove(const Move& move, UndoInfo& undo);
+		void UnmakeMove(const Move& move, const UndoInfo& undo);
+		//Passes the turn, only valid if the side to move is not in check
+		void MakeNullMove(UndoInfo& undo);
+		void UnmakeNullMove(const UndoInfo& undo);
+
+	private:
+		bool _Parse(std::string_view text, bool epd);
+		char* _WriteFields(char* out) const;
+		uint64_t _ComputeKey() const;
+		void _ComputeEvaluation();
+		Bitboard _ComputeAttacks(Side side, Bitboard occupied) const;
+		void _UpdateAttacks();
+		template<Side Us, GenerationType Type>
+		void _GenerateMoves(MoveList& moves, Bitboard origins) const;
+
+	private:
+		Bitboard m_ByKind[KIND_COUNT];
+		Bitboard m_BySide[SIDE_COUNT];
+		//Attack state of the side to move, computed once per position
+		Bitboard m_Checkers;
+		Bitboard m_Pinned;
+		Bitboard m_Attacked;
+		uint64_t m_Key;
+		uint64_t m_PawnKey;
+		Score m_PieceSquare;
+		uint16_t m_HalfMoveClock;
+		uint16_t m_FullMoveNumber;
+		Side m_SideToMove;
+		uint8_t m_Castling;
+		Square m_EnPassant;
+		uint8_t m_Phase;
+	};
+
+	static_assert(std::is_trivially_copyable_v<Position>, "Position has to be trivially copyable");
+	//The members padded to the alignment fill exactly two cache lines, a new member has to fit in the padding
+	static_assert(sizeof(Position) == 2 * CACHE_LINE_SIZE, "Position has to be 128 bytes");
+
+	inline Bitboard Position::GetPieces() const { return m_BySide[WHITE_SIDE] | m_BySide[BLACK_SIDE]; }
+	inline Bitboard Position::GetPieces(Side side) const { return m_BySide[side]; }
+	inline Bitboard Position::GetPieces(Kind kind) const { return m_ByKind[kind]; }
+	inline Bitboard Position::GetPieces(Side side, Kind kind) const { return m_BySide[side] & m_ByKind[kind]; }
+	inline bool Position::IsEmpty(Square square) const { return !(GetPieces() & SquareBB(square)); }
+	inline Side Position::GetSideOn(Square square) const { return (m_BySide[BLACK_SIDE] & SquareBB(square)) ? BLACK_SIDE : WHITE_SIDE; }
+	inline Square Position::GetKingSquare(Side side) const { return Lsb(GetPieces(side, KING)); }
+	inline Side Position::GetSideToMove() const { return m_SideToMove; }
+	inline uint8_t Position::GetCastling() const { return m_Castling; }
+	inline Square Position::GetEnPassant() const { return m_EnPassant; }
+	inline uint16_t Position::GetHalfMoveClock() const { return m_HalfMoveClock; }
+	inline uint16_t Position::GetFullMoveNumber() const { return m_FullMoveNumber; }
+	inline uint64_t Position::GetKey() const { return m_Key; }
+	inline uint64_t Position::GetPawnKey() const { return m_PawnKey; }
+	inline Score Position::GetPieceSquare() const { return m_PieceSquare; }
+	inline int Position::GetPhase() const { return m_Phase; }
+	inline bool Position::IsAttacked(Square square, Side by) const { return GetAttackersTo(square, GetPieces()) & GetPieces(by); }
+	inline bool Position::IsCastling(const Move& move) const { return move.GetType() == MOVE_CASTLING; }
+	//Squares attacked by the side not to move, the king of the side to move does not block them
+	inline Bitboard Position::GetAttacked() const { return m_Attacked; }
+	inline Bitboard Position::GetCheckers() const { return m_Checkers; }
+	inline Bitboard Position::GetPinned() const { return m_Pinned; }
+	inline bool Position::InCheck() const { return m_Checkers != 0; }
+}
\ No newline at end of file
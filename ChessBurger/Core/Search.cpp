@@ -0,0 +1,490 @@
+#include "Search.h"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+namespace Chess
+{
+	//Nodes between two looks at the clock
+	static constexpr uint64_t TIME_CHECK_NODES = 2048;
+	static constexpr int HISTORY_LIMIT = 1 << 18;
+
+	//Move ordering: the line of the previous iteration, the move of the table, winning captures, killers, quiets by history and losing captures last
+	static constexpr int LINE_SCORE = 1 << 30;
+	static constexpr int CAPTURE_SCORE = 1 << 24;
+	static constexpr int KILLER_SCORE = 1 << 20;
+	static constexpr int BAD_CAPTURE_SCORE = -(1 << 24);
+
+	//Mate scores are stored relative to the node, so they stay right when the position is reached at another ply
+	static int _ToTable(int score, int ply)
+	{
+		return score >= MATE_BOUND ? score + ply : score <= -MATE_BOUND ? score - ply : score;
+	}
+
+	static int _FromTable(int score, int ply)
+	{
+		return score >= MATE_BOUND ? score - ply : score <= -MATE_BOUND ? score + ply : score;
+	}
+
+	Search::Search(TranspositionTable& table, int threads)
+		: m_Table(table), m_Pawns(), m_Network(nullptr), m_Accumulators(MAX_PLY + 1), m_Helpers(), m_Stop(false), m_Nodes(0), m_Time(0), m_RootDepth(0), m_Start(), m_Keys(), m_RootIndex(0), m_NullPly(-1), m_Excluded(), m_PreviousLine(), m_FollowLine(false)
+	{
+		std::fill(&m_Killers[0][0], &m_Killers[0][0] + MAX_PLY * 2, Move::None());
+		std::memset(m_History, 0, sizeof(m_History));
+		std::memset(m_LineLengths, 0, sizeof(m_LineLengths));
+		SetThreads(threads);
+	}
+
+	Move Search::Run(const Position& root, const std::vector<uint64_t>& history, const SearchLimits& limits, const Callback& callback)
+	{
+		m_Stop = false;
+		for (auto& helper : m_Helpers)
+			helper->m_Stop = false;
+		m_Table.NewSearch();
+
+		//The helpers have no time limit, they run until the main thread is done
+		SearchLimits helperLimits = limits;
+		helperLimits.Time = 0;
+		helperLimits.Lines = 1;
+		std::vector<std::thread> threads;
+		for (size_t i = 0; i < m_Helpers.size(); i++)
+			threads.emplace_back([this, i, &root, &history, &helperLimits]() { m_Helpers[i]->_Iterate(root, history, helperLimits, (int)i + 1, nullptr); });
+
+		Move best = _Iterate(root, history, limits, 0, callback);
+		Stop();
+		for (std::thread& thread : threads)
+			thread.join();
+		return best;
+	}
+
+	void Search::Stop()
+	{
+		m_Stop = true;
+		for (auto& helper : m_Helpers)
+			helper->m_Stop = true;
+	}
+
+	void Search::SetThreads(int threads)
+	{
+		if (threads <= 0)
+			threads = (int)std::max(1u, std::thread::hardware_concurrency());
+		m_Helpers.clear();
+		for (int i = 1; i < threads; i++)
+		{
+			m_Helpers.push_back(std::make_unique<Search>(m_Table));
+			m_Helpers.back()->m_Network = m_Network;
+		}
+	}
+
+	void Search::SetNetwork(const Network* network)
+	{
+		m_Network = network;
+		for (auto& helper : m_Helpers)
+			helper->m_Network = network;
+	}
+
+	Move Search::_Iterate(const Position& root, const std::vector<uint64_t>& history, const SearchLimits& limits, int index, const Callback& callback)
+	{
+		m_Nodes = 0;
+		m_Time = limits.Time;
+		m_Start = std::chrono::steady_clock::now();
+		m_Keys = history;
+		m_RootIndex = history.size();
+		m_Keys.resize(m_RootIndex + MAX_PLY + 1);
+		m_Keys[m_RootIndex] = root.GetKey();
+		m_NullPly = -1;
+		std::fill(&m_Killers[0][0], &m_Killers[0][0] + MAX_PLY * 2, Move::None());
+		std::memset(m_History, 0, sizeof(m_History));
+
+		MoveList rootMoves;
+		root.GenerateMoves<LEGAL>(rootMoves);
+		if (rootMoves.IsEmpty())
+			return Move::None();
+
+		int lines = std::clamp(limits.Lines, 1, rootMoves.GetSize());
+		int maxDepth = std::clamp(limits.Depth, 1, MAX_PLY - 1);
+		Position position = root;
+		if (m_Network)
+			m_Network->Refresh(position, m_Accumulators[0]);
+		Move best = rootMoves[0];
+		std::vector<SearchLine> previous;
+		//Every other helper starts one iteration deeper, so the threads spread over the depths
+		for (m_RootDepth = 1 + (index & 1); m_RootDepth <= maxDepth; m_RootDepth++)
+		{
+			//The lines after the first one are searched without the root moves of the better lines
+			std::vector<SearchLine> current;
+			m_Excluded.Clear();
+			for (int i = 0; i < lines; i++)
+			{
+				m_PreviousLine = i < (int)previous.size() ? previous[i].Moves : std::vector<Move>();
+				m_FollowLine = true;
+				int score = _Search(position, -INFINITE_SCORE, INFINITE_SCORE, m_RootDepth, 0, true);
+				if (m_Stop)
+					break;
+				current.push_back({ score, std::vector<Move>(m_Lines[0], m_Lines[0] + m_LineLengths[0]) });
+				m_Excluded.Add(m_Lines[0][0]);
+			}
+
+			//An unfinished iteration is thrown away unless there is nothing else
+			if (m_Stop)
+			{
+				if (previous.empty() && !current.empty())
+					best = current[0].Moves[0];
+				break;
+			}
+
+			std::stable_sort(current.begin(), current.end(), [](const SearchLine& a, const SearchLine& b) { return a.Score > b.Score; });
+			previous = current;
+			best = current[0].Moves[0];
+			if (callback)
+				callback({ m_RootDepth, _GetNodes(), _GetElapsed(), m_Table.GetHashfull(), current });
+
+			//The next iteration would not finish in the remaining time
+			if (m_Time > 0 && (_GetElapsed() * 2 > m_Time || std::abs(current[0].Score) >= MATE_BOUND))
+				break;
+		}
+		return best;
+	}
+
+	int Search::_Search(Position& position, int alpha, int beta, int depth, int ply, bool pvNode)
+	{
+		m_LineLengths[ply] = ply;
+		if (depth <= 0)
+			return _Quiescence(position, alpha, beta, ply);
+
+		_CountNode();
+		if (m_Stop)
+			return 0;
+
+		if (ply > 0)
+		{
+			if (position.GetHalfMoveClock() >= 100 || _IsRepetition(position, ply))
+				return 0;
+
+			//No mate found later can be faster than one already found
+			alpha = std::max(alpha, -MATE_SCORE + ply);
+			beta = std::min(beta, MATE_SCORE - ply - 1);
+			if (alpha >= beta)
+				return alpha;
+		}
+		if (ply >= MAX_PLY - 1)
+			return _Evaluate(position, ply);
+
+		//A deep enough result of the same position ends the node, except on the principal variation
+		TableHit hit;
+		bool found = m_Table.Probe(position.GetKey(), hit);
+		if (found && !pvNode && hit.Depth >= depth)
+		{
+			int score = _FromTable(hit.Score, ply);
+			if (hit.Bound == BOUND_EXACT || (hit.Bound == BOUND_LOWER && score >= beta) || (hit.Bound == BOUND_UPPER && score <= alpha))
+				return score;
+		}
+
+		bool inCheck = position.InCheck();
+		Side us = position.GetSideToMove();
+		int evaluation = found ? hit.Evaluation : inCheck ? 0 : _Evaluate(position, ply);
+
+		//Null move pruning, if passing the turn still fails high the node is not worth searching
+		//Without pieces zugzwang is too common for it
+		Bitboard pieces = position.GetPieces(us) & ~position.GetPieces(PAWN) & ~position.GetPieces(KING);
+		if (!pvNode && !inCheck && depth >= 3 && pieces && evaluation >= beta)
+		{
+			UndoInfo undo;
+			position.MakeNullMove(undo);
+			if (m_Network)
+				m_Accumulators[ply + 1] = m_Accumulators[ply];
+			m_Keys[m_RootIndex + ply + 1] = position.GetKey();
+			bool followLine = m_FollowLine;
+			int nullPly = m_NullPly;
+			m_FollowLine = false;
+			m_NullPly = ply + 1;
+			int score = -_Search(position, -beta, -beta + 1, depth - 3 - depth / 6, ply + 1, false);
+			m_FollowLine = followLine;
+			m_NullPly = nullPly;
+			position.UnmakeNullMove(undo);
+			if (m_Stop)
+				return 0;
+			if (score >= beta)
+				return score >= MATE_BOUND ? beta : score;
+		}
+
+		MoveList list;
+		position.GenerateMoves<LEGAL>(list);
+		if (list.IsEmpty())
+			return inCheck ? -MATE_SCORE + ply : 0;
+
+		Move moves[MoveList::CAPACITY];
+		int scores[MoveList::CAPACITY];
+		int count = _ScoreMoves(position, list, moves, scores, found ? hit.BestMove : Move::None(), ply);
+
+		int originalAlpha = alpha;
+		int best = -INFINITE_SCORE;
+		Move bestMove = Move::None();
+		int searched = 0;
+		for (int i = 0; i < count; i++)
+		{
+			//Pick the best of the remaining moves, the rest is often never needed
+			int next = i;
+			for (int j = i + 1; j < count; j++)
+				if (scores[j] > scores[next])
+					next = j;
+			std::swap(moves[i], moves[next]);
+			std::swap(scores[i], scores[next]);
+			Move move = moves[i];
+			if (ply == 0 && m_Excluded.Contains(move))
+				continue;
+
+			bool quiet = !position.IsCapture(move) && move.GetPromotion() == NO_KIND;
+			if (scores[i] != LINE_SCORE)
+				m_FollowLine = false;
+
+			UndoInfo undo;
+			_MakeMove(position, move, undo, ply);
+			m_Keys[m_RootIndex + ply + 1] = position.GetKey();
+			bool givesCheck = position.InCheck();
+			int newDepth = depth - 1 + (givesCheck ? 1 : 0);
+
+			int score;
+			if (searched == 0)
+				score = -_Search(position, -beta, -alpha, newDepth, ply + 1, pvNode);
+			else
+			{
+				//Late quiet moves are searched shallower first, they rarely turn out to be the best
+				int reduction = depth >= 3 && searched >= 3 && quiet && !inCheck && !givesCheck ? 1 + (searched >= 10) : 0;
+				score = -_Search(position, -alpha - 1, -alpha, newDepth - reduction, ply + 1, false);
+				if (score > alpha && reduction)
+					score = -_Search(position, -alpha - 1, -alpha, newDepth, ply + 1, false);
+				if (score > alpha && score < beta)
+					score = -_Search(position, -beta, -alpha, newDepth, ply + 1, true);
+			}
+			position.UnmakeMove(move, undo);
+			if (m_Stop)
+				return 0;
+			searched++;
+
+			if (score > best)
+			{
+				best = score;
+				if (score > alpha)
+				{
+					alpha = score;
+					bestMove = move;
+					m_Lines[ply][ply] = move;
+					for (int j = ply + 1; j < m_LineLengths[ply + 1]; j++)
+						m_Lines[ply][j] = m_Lines[ply + 1][j];
+					m_LineLengths[ply] = std::max(m_LineLengths[ply + 1], ply + 1);
+
+					if (score >= beta)
+					{
+						if (quiet)
+						{
+							if (m_Killers[ply][0] != move)
+							{
+								m_Killers[ply][1] = m_Killers[ply][0];
+								m_Killers[ply][0] = move;
+							}
+							int& history = m_History[us][move.GetFrom()][move.GetTo()];
+							history += depth * depth;
+							if (history > HISTORY_LIMIT)
+								for (auto& table : m_History)
+									for (auto& row : table)
+										for (int& value : row)
+											value /= 2;
+						}
+						break;
+					}
+				}
+			}
+		}
+
+		//The root of the later lines misses the excluded moves, its result is not the one of the position
+		if (ply > 0 || m_Excluded.IsEmpty())
+		{
+			BoundType bound = best >= beta ? BOUND_LOWER : best > originalAlpha ? BOUND_EXACT : BOUND_UPPER;
+			m_Table.Store(position.GetKey(), bestMove, _ToTable(best, ply), evaluation, depth, bound);
+		}
+		return best;
+	}
+
+	//Only captures and queen promotions are searched until the position is quiet, the side to move may stand pat
+	int Search::_Quiescence(Position& position, int alpha, int beta, int ply)
+	{
+		m_LineLengths[ply] = ply;
+		_CountNode();
+		if (m_Stop)
+			return 0;
+		if (ply >= MAX_PLY - 1)
+			return _Evaluate(position, ply);
+
+		TableHit hit;
+		bool found = m_Table.Probe(position.GetKey(), hit);
+		if (found)
+		{
+			int score = _FromTable(hit.Score, ply);
+			if (hit.Bound == BOUND_EXACT || (hit.Bound == BOUND_LOWER && score >= beta) || (hit.Bound == BOUND_UPPER && score <= alpha))
+				return score;
+		}
+
+		bool inCheck = position.InCheck();
+		int evaluation = found ? hit.Evaluation : inCheck ? 0 : _Evaluate(position, ply);
+		int originalAlpha = alpha;
+		int best = -MATE_SCORE + ply;
+		Move bestMove = Move::None();
+		MoveList list;
+		if (inCheck)
+		{
+			position.GenerateMoves<EVASIONS>(list);
+			if (list.IsEmpty())
+				return best;
+		}
+		else
+		{
+			best = evaluation;
+			if (best >= beta)
+				return best;
+			alpha = std::max(alpha, best);
+			position.GenerateMoves<CAPTURES>(list);
+		}
+
+		Move moves[MoveList::CAPACITY];
+		int scores[MoveList::CAPACITY];
+		int count = _ScoreMoves(position, list, moves, scores, found ? hit.BestMove : Move::None(), ply);
+		for (int i = 0; i < count; i++)
+		{
+			int next = i;
+			for (int j = i + 1; j < count; j++)
+				if (scores[j] > scores[next])
+					next = j;
+			std::swap(moves[i], moves[next]);
+			std::swap(scores[i], scores[next]);
+			Move move = moves[i];
+
+			//Losing captures and under promotions can not raise the score of a quiet position
+			if (!inCheck && (scores[i] < 0 || (move.GetPromotion() != NO_KIND && move.GetPromotion() != QUEEN)))
+				continue;
+
+			UndoInfo undo;
+			_MakeMove(position, move, undo, ply);
+			m_Keys[m_RootIndex + ply + 1] = position.GetKey();
+			int score = -_Quiescence(position, -beta, -alpha, ply + 1);
+			position.UnmakeMove(move, undo);
+			if (m_Stop)
+				return 0;
+
+			if (score > best)
+			{
+				best = score;
+				if (score > alpha)
+				{
+					alpha = score;
+					bestMove = move;
+					if (score >= beta)
+						break;
+				}
+			}
+		}
+
+		BoundType bound = best >= beta ? BOUND_LOWER : best > originalAlpha ? BOUND_EXACT : BOUND_UPPER;
+		m_Table.Store(position.GetKey(), bestMove, _ToTable(best, ply), evaluation, 0, bound);
+		return best;
+	}
+
+	int Search::_ScoreMoves(const Position& position, const MoveList& list, Move* moves, int* scores, const Move& tableMove, int ply) const
+	{
+		Move lineMove = m_FollowLine && ply < (int)m_PreviousLine.size() ? m_PreviousLine[ply] : Move::None();
+		Side us = position.GetSideToMove();
+		int count = 0;
+		for (const Move& move : list)
+		{
+			int score;
+			Kind victim = move.GetType() == MOVE_EN_PASSANT ? PAWN : position.GetKindOn(move.GetTo());
+			Kind promotion = move.GetPromotion();
+			if (move == lineMove)
+				score = LINE_SCORE;
+			else if (move == tableMove)
+				score = LINE_SCORE - 1;
+			else if (victim != NO_KIND || promotion == QUEEN)
+			{
+				//Most valuable victim first, then least valuable attacker
+				int value = (victim != NO_KIND ? PieceValues[victim] : 0) + (promotion == QUEEN ? PieceValues[QUEEN] : 0);
+				score = value * 8 - position.GetKindOn(move.GetFrom());
+				score += position.StaticExchange(move) >= 0 ? CAPTURE_SCORE : BAD_CAPTURE_SCORE;
+			}
+			else if (move == m_Killers[ply][0])
+				score = KILLER_SCORE + 1;
+			else if (move == m_Killers[ply][1])
+				score = KILLER_SCORE;
+			else
+				score = m_History[us][move.GetFrom()][move.GetTo()] - (promotion != NO_KIND ? HISTORY_LIMIT : 0);
+			moves[count] = move;
+			scores[count++] = score;
+		}
+		return count;
+	}
+
+	//A position that already occured since the last irreversible move is a draw, in the search one repetition is enough
+	bool Search::_IsRepetition(const Position& position, int ply) const
+	{
+		//The halfmove clock counts the null moves as well, but the positions before a pass never lead to this one in a game
+		size_t index = m_RootIndex + ply;
+		size_t distance = std::min((size_t)position.GetHalfMoveClock(), index);
+		if (m_NullPly >= 0)
+			distance = std::min(distance, (size_t)(ply - m_NullPly));
+
+		//A position of the game before the root only repeated once, it has to be there twice
+		bool repeated = false;
+		for (size_t i = 4; i <= distance; i += 2)
+		{
+			if (m_Keys[index - i] == position.GetKey())
+			{
+				if (index - i > m_RootIndex || repeated)
+					return true;
+				repeated = true;
+			}
+		}
+		return false;
+	}
+
+	void Search::_CountNode()
+	{
+		uint64_t nodes = m_Nodes.load(std::memory_order_relaxed) + 1;
+		m_Nodes.store(nodes, std::memory_order_relaxed);
+		if (nodes % TIME_CHECK_NODES == 0)
+			_CheckTime();
+	}
+
+	int Search::_Evaluate(const Position& position, int ply)
+	{
+		if (m_Network)
+			return std::clamp(m_Network->Evaluate(m_Accumulators[ply], position.GetSideToMove()), -MATE_BOUND + 1, MATE_BOUND - 1);
+		return Evaluate(position, m_Pawns);
+	}
+
+	//The accumulator of the next ply follows the move, so the network never has to look at the whole board
+	void Search::_MakeMove(Position& position, const Move& move, UndoInfo& undo, int ply)
+	{
+		position.MakeMove(move, undo);
+		if (m_Network)
+			m_Network->Update(m_Accumulators[ply], m_Accumulators[ply + 1], position, move, undo);
+	}
+
+	uint64_t Search::_GetNodes() const
+	{
+		uint64_t nodes = m_Nodes.load(std::memory_order_relaxed);
+		for (const auto& helper : m_Helpers)
+			nodes += helper->m_Nodes.load(std::memory_order_relaxed);
+		return nodes;
+	}
+
+	void Search::_CheckTime()
+	{
+		//The first iteration always finishes, so there is a move to play
+		if (m_Time > 0 && m_RootDepth > 1 && _GetElapsed() >= m_Time)
+			m_Stop = true;
+	}
+
+	int64_t Search::_GetElapsed() const
+	{
+		return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_Start).count();
+	}
+}
\ No newline at end of file
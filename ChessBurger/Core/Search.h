@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Evaluation.h"
+#include "Network.h"
+#include "Position.h"
+#include "Transposition.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Chess
+{
+	constexpr int MAX_PLY = 64;
+	constexpr int INFINITE_SCORE = 32001;
+	constexpr int MATE_SCORE = 32000;
+	//Scores beyond the bound are mates, the plies to the mate are the distance from MATE_SCORE
+	constexpr int MATE_BOUND = MATE_SCORE - MAX_PLY;
+
+	struct SearchLimits
+	{
+		int Depth = MAX_PLY - 1;
+		int64_t Time = 0; //Milliseconds for the search, it runs until stopped if it is 0
+		int Lines = 1;
+	};
+
+	struct SearchLine
+	{
+		int Score;
+		std::vector<Move> Moves;
+	};
+
+	//Result of a finished iteration, the lines are ordered from the best to the worst
+	struct SearchReport
+	{
+		int Depth;
+		uint64_t Nodes;
+		int64_t Time;
+		int Hashfull;
+		std::vector<SearchLine> Lines;
+	};
+
+	//Iterative deepening principal variation search with quiescence, it runs on the calling thread and the helper threads
+	//The helpers search the same root without talking to each other, they only share the transposition table (Lazy SMP)
+	//The table outlives the search, so the next search starts with its results
+	class Search
+	{
+	public:
+		typedef std::function<void(const SearchReport&)> Callback;
+
+	public:
+		Search(TranspositionTable& table, int threads = 1);
+
+		//The history holds the keys of the game positions before the root, for the repetitions
+		Move Run(const Position& root, const std::vector<uint64_t>& history, const SearchLimits& limits, const Callback& callback = nullptr);
+		void Stop();
+		bool IsStopped() const;
+		//All hardware threads are used if it is 0, it must not be called during a search
+		void SetThreads(int threads);
+		int GetThreads() const;
+		//The network evaluates the positions instead of the hand written evaluation if it is set, it must outlive the search
+		void SetNetwork(const Network* network);
+
+	private:
+		Move _Iterate(const Position& root, const std::vector<uint64_t>& history, const SearchLimits& limits, int index, const Callback& callback);
+		void _CountNode();
+		int _Evaluate(const Position& position, int ply);
+		void _MakeMove(Position& position, const Move& move, UndoInfo& undo, int ply);
+		uint64_t _GetNodes() const;
+		int _Search(Position& position, int alpha, int beta, int depth, int ply, bool pvNode);
+		int _Quiescence(Position& position, int alpha, int beta, int ply);
+		int _ScoreMoves(const Position& position, const MoveList& list, Move* moves, int* scores, const Move& tableMove, int ply) const;
+		bool _IsRepetition(const Position& position, int ply) const;
+		void _CheckTime();
+		int64_t _GetElapsed() const;
+
+	private:
+		TranspositionTable& m_Table;
+		PawnHash m_Pawns;
+		const Network* m_Network;
+		//Accumulator of the position at each ply of the current path
+		std::vector<Accumulator> m_Accumulators;
+		std::vector<std::unique_ptr<Search>> m_Helpers;
+		std::atomic<bool> m_Stop;
+		//Only written by the thread of the search, the main thread sums them up
+		std::atomic<uint64_t> m_Nodes;
+		int64_t m_Time;
+		int m_RootDepth;
+		std::chrono::steady_clock::time_point m_Start;
+		//Keys of the game followed by the keys of the current search path
+		std::vector<uint64_t> m_Keys;
+		size_t m_RootIndex;
+		//Ply of the position after the last null move on the current path, -1 if there is none
+		int m_NullPly;
+		MoveList m_Excluded;
+		//Line of the previous iteration, it is searched first
+		std::vector<Move> m_PreviousLine;
+		bool m_FollowLine;
+		Move m_Lines[MAX_PLY][MAX_PLY];
+		int m_LineLengths[MAX_PLY];
+		Move m_Killers[MAX_PLY][2];
+		int m_History[SIDE_COUNT][SQUARE_COUNT][SQUARE_COUNT];
+	};
+
+	inline int Search::GetThreads() const { return (int)m_Helpers.size() + 1; }
+	inline bool Search::IsStopped() const { return m_Stop; }
+}
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include "Transposition.h"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#if defined(_WIN32)
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <Windows.h>
+#elif defined(__linux__)
+	#include <sys/mman.h>
+#endif
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+namespace Chess
+{
+	//Layout of the data: move in bits 0-15, score in 16-31, evaluation in 32-47, depth in 48-55, bound in 56-57 and generation in 58-63
+	static constexpr int GENERATION_SHIFT = 58;
+	static constexpr uint8_t GENERATION_MASK = 63;
+	//An entry loses this much depth for every search it is older
+	static constexpr int AGE_WEIGHT = 8;
+	static constexpr size_t HASHFULL_SAMPLE = 1000;
+
+	static uint64_t _Pack(const Move& move, int score, int evaluation, int depth, BoundType bound, uint8_t generation)
+	{
+		return (uint64_t)move.GetData() | ((uint64_t)(uint16_t)score << 16) | ((uint64_t)(uint16_t)evaluation << 32)
+			| ((uint64_t)(uint8_t)depth << 48) | ((uint64_t)bound << 56) | ((uint64_t)generation << GENERATION_SHIFT);
+	}
+
+	static int _GetDepth(uint64_t data) { return (int)((data >> 48) & 0xFF); }
+	static uint8_t _GetGeneration(uint64_t data) { return (uint8_t)(data >> GENERATION_SHIFT); }
+
+	//Large pages save most of the TLB misses of the random accesses, they are used where the system allows it
+	static void* _Allocate(size_t size)
+	{
+#if defined(_WIN32)
+		//Needs the lock pages in memory privilege, without it the normal pages are used
+		size_t largePage = GetLargePageMinimum();
+		if (largePage)
+		{
+			void* memory = VirtualAlloc(nullptr, (size + largePage - 1) / largePage * largePage, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+			if (memory)
+				return memory;
+		}
+		return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#elif defined(__linux__)
+		//Transparent huge pages are only used for memory aligned to them
+		constexpr size_t HugePage = 2 * 1024 * 1024;
+		size_t rounded = (size + HugePage - 1) / HugePage * HugePage;
+		void* memory = std::aligned_alloc(HugePage, rounded);
+		if (memory)
+			madvise(memory, rounded, MADV_HUGEPAGE);
+		return memory;
+#else
+		return std::aligned_alloc(64, size);
+#endif
+	}
+
+	static void _Deallocate(void* memory)
+	{
+#if defined(_WIN32)
+		if (memory)
+			VirtualFree(memory, 0, MEM_RELEASE);
+#else
+		std::free(memory);
+#endif
+	}
+
+	TranspositionTable::TranspositionTable(size_t megabytes)
+		: m_Buckets(nullptr), m_BucketCount(0), m_Generation(0)
+	{
+		Resize(megabytes);
+	}
+
+	TranspositionTable::~TranspositionTable()
+	{
+		_Free();
+	}
+
+	void TranspositionTable::Resize(size_t megabytes)
+	{
+		//The old table is freed first, so the memory is there for the new one
+		//If the system can not give that much, the size is halved until it can
+		_Free();
+		megabytes = std::min(megabytes, SIZE_MAX / (1024 * 1024));
+		for (size_t count = std::max<size_t>(megabytes * 1024 * 1024 / sizeof(Bucket), 1); count > 0 && !m_Buckets; count /= 2)
+		{
+			m_Buckets = (Bucket*)_Allocate(count * sizeof(Bucket));
+			m_BucketCount = m_Buckets ? count : 0;
+		}
+		if (!m_Buckets)
+			throw std::bad_alloc();
+		Clear();
+	}
+
+	void TranspositionTable::Clear()
+	{
+		std::memset((void*)m_Buckets, 0, m_BucketCount * sizeof(Bucket));
+		m_Generation = 0;
+	}
+
+	void TranspositionTable::NewSearch()
+	{
+		m_Generation = (m_Generation + 1) & GENERATION_MASK;
+	}
+
+	bool TranspositionTable::Probe(uint64_t key, TableHit& hit) const
+	{
+		const Bucket& bucket = _GetBucket(key);
+		for (const Entry& entry : bucket.Entries)
+		{
+			uint64_t data = entry.Data.load(std::memory_order_relaxed);
+			if ((entry.Key.load(std::memory_order_relaxed) ^ data) != key)
+				continue;
+
+			hit.BestMove = Move::FromData((uint16_t)data);
+			hit.Score = (int16_t)(data >> 16);
+			hit.Evaluation = (int16_t)(data >> 32);
+			hit.Depth = (uint8_t)_GetDepth(data);
+			hit.Bound = (BoundType)((data >> 56) & 3);
+			return hit.Bound != BOUND_NONE;
+		}
+		return false;
+	}
+
+	void TranspositionTable::Store(uint64_t key, const Move& move, int score, int evaluation, int depth, BoundType bound)
+	{
+		//The same position is overwritten, otherwise the shallowest and oldest entry of the bucket
+		Bucket& bucket = _GetBucket(key);
+		Entry* replace = &bucket.Entries[0];
+		Move bestMove = move;
+		int worst = INT_MAX;
+		for (Entry& entry : bucket.Entries)
+		{
+			uint64_t data = entry.Data.load(std::memory_order_relaxed);
+			if ((entry.Key.load(std::memory_order_relaxed) ^ data) == key)
+			{
+				//A bound of the current search from a much deeper search is worth more than the new one
+				if (bound != BOUND_EXACT && _GetGeneration(data) == m_Generation && depth + 2 < _GetDepth(data))
+					return;
+				if (bestMove == Move::None())
+					bestMove = Move::FromData((uint16_t)data);
+				replace = &entry;
+				break;
+			}
+
+			int value = data == 0 ? INT_MIN : _GetDepth(data) - AGE_WEIGHT * ((m_Generation - _GetGeneration(data)) & GENERATION_MASK);
+			if (value < worst)
+			{
+				worst = value;
+				replace = &entry;
+			}
+		}
+
+		uint64_t data = _Pack(bestMove, score, evaluation, depth, bound, m_Generation);
+		replace->Key.store(key ^ data, std::memory_order_relaxed);
+		replace->Data.store(data, std::memory_order_relaxed);
+	}
+
+	int TranspositionTable::GetHashfull() const
+	{
+		size_t buckets = std::min(m_BucketCount, HASHFULL_SAMPLE / BUCKET_SIZE);
+		size_t used = 0;
+		for (size_t i = 0; i < buckets; i++)
+		{
+			for (const Entry& entry : m_Buckets[i].Entries)
+			{
+				uint64_t data = entry.Data.load(std::memory_order_relaxed);
+				if (data && _GetGeneration(data) == m_Generation)
+					used++;
+			}
+		}
+		return (int)(used * 1000 / (buckets * BUCKET_SIZE));
+	}
+
+	TranspositionTable::Bucket& TranspositionTable::_GetBucket(uint64_t key) const
+	{
+		//High half of the product maps the key evenly onto any number of buckets
+#if defined(_MSC_VER)
+		return m_Buckets[__umulh(key, m_BucketCount)];
+#else
+		return m_Buckets[(size_t)(((unsigned __int128)key * m_BucketCount) >> 64)];
+#endif
+	}
+
+	void TranspositionTable::_Free()
+	{
+		_Deallocate(m_Buckets);
+		m_Buckets = nullptr;
+		m_BucketCount = 0;
+	}
+}
\ No newline at end of file
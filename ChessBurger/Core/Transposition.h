@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Move.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Chess
+{
+	enum BoundType : uint8_t
+	{
+		BOUND_NONE = 0, BOUND_UPPER, BOUND_LOWER, BOUND_EXACT
+	};
+
+	//Unpacked copy of an entry, the score is relative to the node it was stored at
+	struct TableHit
+	{
+		Move BestMove;
+		int16_t Score;
+		int16_t Evaluation;
+		uint8_t Depth;
+		BoundType Bound;
+	};
+
+	//Search results shared by any number of threads without locks
+	//Every entry is 16 bytes, the key is stored xored with the data, so a torn write of another thread never verifies
+	class TranspositionTable
+	{
+	public:
+		static constexpr size_t BUCKET_SIZE = 4;
+		static constexpr size_t DEFAULT_SIZE = 64; //Megabytes
+
+	public:
+		TranspositionTable(size_t megabytes = DEFAULT_SIZE);
+		~TranspositionTable();
+		TranspositionTable(const TranspositionTable&) = delete;
+		TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+		//Resizing and clearing must not overlap a search
+		//A size the system can not allocate is halved until it can, GetSize returns the size in use
+		void Resize(size_t megabytes);
+		void Clear();
+		//Entries of the earlier searches are replaced first
+		void NewSearch();
+
+		bool Probe(uint64_t key, TableHit& hit) const;
+		void Store(uint64_t key, const Move& move, int score, int evaluation, int depth, BoundType bound);
+		//Permille of the sampled entries written by the current search
+		int GetHashfull() const;
+		size_t GetSize() const;
+
+	private:
+		struct Entry
+		{
+			std::atomic<uint64_t> Key;
+			std::atomic<uint64_t> Data;
+		};
+
+		struct alignas(64) Bucket
+		{
+			Entry Entries[BUCKET_SIZE];
+		};
+
+		static_assert(sizeof(Entry) == 16, "Entry has to be 16 bytes");
+		static_assert(sizeof(Bucket) == 64, "Bucket has to fill a cache line");
+
+	private:
+		Bucket& _GetBucket(uint64_t key) const;
+		void _Free();
+
+	private:
+		Bucket* m_Buckets;
+		size_t m_BucketCount;
+		uint8_t m_Generation;
+	};
+
+	inline size_t TranspositionTable::GetSize() const { return m_BucketCount * sizeof(Bucket); }
+}
\ No newline at end of file
@@ -0,0 +1,213 @@
+#include "BuiltinEngine.h"
+#include "GameData/GameData.h"
+#include "Utilities/Utilities.h"
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+
+BuiltinEngine::BuiltinEngine(const std::string& name)
+	: Engine(name), m_Table(), m_Network(), m_Search(m_Table, GameData::EngineThreads), m_Thread(), m_Stopping(false), m_History()
+{
+	m_RootPosition.SetFEN(Chess::START_FEN);
+	//The hand written evaluation is used if there is no network next to the other assets
+	if (m_Network.Load("assets/network.nnue"))
+		m_Search.SetNetwork(&m_Network);
+}
+
+BuiltinEngine::~BuiltinEngine()
+{
+	Stop();
+}
+
+bool BuiltinEngine::Init()
+{
+	return true;
+}
+
+void BuiltinEngine::ResetForAnalyzing()
+{
+	if (m_Mode != Mode::ANALYZE)
+	{
+		Stop();
+		m_Table.Clear();
+		m_Mode = Mode::ANALYZE;
+	}
+}
+
+void BuiltinEngine::ResetForPlaying()
+{
+	if (m_Mode != Mode::PLAY)
+	{
+		Stop();
+		m_Table.Clear();
+		m_Mode = Mode::PLAY;
+	}
+}
+
+void BuiltinEngine::ResetForWaiting()
+{
+	if (m_Mode != Mode::WAIT)
+	{
+		Stop();
+		m_Mode = Mode::WAIT;
+	}
+}
+
+void BuiltinEngine::SetPosition(const std::string& fen)
+{
+	Stop();
+	m_AnalysisData.Depth = 0;
+	m_BestMove = Chess::Move::None();
+	m_RootPosition.SetFEN(fen);
+	m_WhiteToMove = m_RootPosition.GetSideToMove() == Chess::WHITE_SIDE;
+	m_History.clear();
+	if (m_Mode == Mode::ANALYZE)
+		GoInfinite();
+}
+
+void BuiltinEngine::SetPositionWithMoves(const std::string& moves)
+{
+	Stop();
+	m_AnalysisData.Depth = 0;
+	m_BestMove = Chess::Move::None();
+	m_RootPosition.SetFEN(Chess::START_FEN);
+	m_History.clear();
+	std::stringstream stream(moves);
+	std::string note;
+	while (stream >> note)
+	{
+		Chess::Move move = m_RootPosition.FromUCI(note);
+		if (move == Chess::Move::None())
+			break;
+		Chess::UndoInfo undo;
+		m_History.push_back(m_RootPosition.GetKey());
+		m_RootPosition.MakeMove(move, undo);
+	}
+	m_WhiteToMove = m_RootPosition.GetSideToMove() == Chess::WHITE_SIDE;
+	if (m_Mode == Mode::ANALYZE)
+		GoInfinite();
+}
+
+void BuiltinEngine::SetAnalyseMode(bool)
+{
+}
+
+void BuiltinEngine::GoInfinite()
+{
+	Chess::SearchLimits limits;
+	limits.Lines = GameData::EngineLines;
+	_Start(limits);
+}
+
+void BuiltinEngine::SearchMove(uint32_t wtime, uint32_t btime, uint32_t winc, uint32_t binc)
+{
+	//A fixed share of the remaining time, the increment is mostly spent as well
+	uint32_t time = m_WhiteToMove ? wtime : btime;
+	uint32_t increment = m_WhiteToMove ? winc : binc;
+	Chess::SearchLimits limits;
+	limits.Time = std::max<int64_t>(time / 30 + increment / 2, 50);
+	_Start(limits);
+}
+
+void BuiltinEngine::SendCommand(const std::string& command)
+{
+	//The hash size in megabytes, the threads and the network file can be set like with the UCI engines
+	std::stringstream stream(command);
+	std::string setoption, name, option, value, argument;
+	if (!(stream >> setoption >> name >> option >> value) || setoption != "setoption" || !std::getline(stream >> std::ws, argument))
+		return;
+	Stop();
+	if (option == "EvalFile")
+	{
+		//The scores in the table came from the other evaluation
+		if (m_Network.Load(argument))
+		{
+			m_Search.SetNetwork(&m_Network);
+			m_Table.Clear();
+		}
+		return;
+	}
+
+	int number = std::atoi(argument.c_str());
+	if (number <= 0)
+		return;
+	if (option == "Hash")
+		m_Table.Resize(number);
+	else if (option == "Threads")
+		m_Search.SetThreads(number);
+}
+
+void BuiltinEngine::Stop()
+{
+	m_Stopping = true;
+	m_Search.Stop();
+	if (m_Thread.joinable())
+		m_Thread.join();
+	m_Stopping = false;
+}
+
+void BuiltinEngine::_Start(const Chess::SearchLimits& limits)
+{
+	Stop();
+	Chess::Position root = m_RootPosition;
+	std::vector<uint64_t> history = m_History;
+	//The mode only changes on the main thread after the search is joined
+	bool play = m_Mode == Mode::PLAY;
+	m_Thread = std::thread([this, root, history, limits, play]()
+	{
+		Chess::Move bestMove = m_Search.Run(root, history, limits, [this](const Chess::SearchReport& report) { _Report(report); });
+		//A search stopped from the outside is not published, setting a new position clears the move again after the join
+		std::unique_lock<std::mutex> lock(GameData::EngineMutex, std::defer_lock);
+		if (play && _Lock(lock))
+			m_BestMove = bestMove;
+	});
+}
+
+bool BuiltinEngine::_Lock(std::unique_lock<std::mutex>& lock) const
+{
+	//The board may hold the mutex while it stops the search, so give up instead of blocking the join
+	while (!lock.try_lock())
+	{
+		if (m_Stopping)
+			return false;
+		std::this_thread::yield();
+	}
+	return true;
+}
+
+void BuiltinEngine::_Report(const Chess::SearchReport& report)
+{
+	std::unique_lock<std::mutex> lock(GameData::EngineMutex, std::defer_lock);
+	if (!_Lock(lock))
+		return;
+
+	m_AnalysisData.Depth = report.Depth;
+	m_AnalysisData.Hashfull = report.Hashfull;
+	for (size_t i = 0; i < m_AnalysisData.BestLines.size(); i++)
+	{
+		if (i < report.Lines.size())
+		{
+			m_AnalysisData.BestLines[i] = report.Lines[i].Moves;
+			m_AnalysisData.Evaluations[i] = _FormatScore(report.Lines[i].Score);
+		}
+		else
+		{
+			m_AnalysisData.BestLines[i].clear();
+			m_AnalysisData.Evaluations[i] = "";
+		}
+	}
+}
+
+std::string BuiltinEngine::_FormatScore(int score) const
+{
+	//Same format as the UCI engines, from the point of view of white
+	if (!m_WhiteToMove)
+		score = -score;
+	if (std::abs(score) >= Chess::MATE_BOUND)
+	{
+		int moves = (Chess::MATE_SCORE - std::abs(score) + 1) / 2;
+		return (score >= 0 ? "+M" : "-M") + std::to_string(moves);
+	}
+	float eval = score / 100.0f;
+	return (eval >= 0 ? "+" : "-") + Utils::Round(std::abs(eval), 2);
+}
\ No newline at end of file
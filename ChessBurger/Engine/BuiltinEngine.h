@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Engine.h"
+#include "Core/Network.h"
+#include "Core/Search.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <thread>
+
+//Engine searching in the process on a thread of its own, it is used when there is no UCI engine
+class BuiltinEngine : public Engine
+{
+public:
+	BuiltinEngine(const std::string& name);
+	~BuiltinEngine();
+
+	bool Init() override;
+	void ResetForAnalyzing() override;
+	void ResetForPlaying() override;
+	void ResetForWaiting() override;
+	void SetPosition(const std::string& fen) override;
+	void SetPositionWithMoves(const std::string& moves) override;
+	void SetAnalyseMode(bool value) override;
+	void GoInfinite() override;
+	void SearchMove(uint32_t wtime, uint32_t btime, uint32_t winc, uint32_t binc) override;
+	void SendCommand(const std::string& command) override;
+	void Stop() override;
+
+private:
+	void _Start(const Chess::SearchLimits& limits);
+	//Locks the engine mutex unless the search is stopped from the outside while waiting for it
+	bool _Lock(std::unique_lock<std::mutex>& lock) const;
+	void _Report(const Chess::SearchReport& report);
+	std::string _FormatScore(int score) const;
+
+private:
+	Chess::TranspositionTable m_Table;
+	Chess::Network m_Network;
+	Chess::Search m_Search;
+	std::thread m_Thread;
+	//Set while the main thread stops the search, the search also stops itself when it is done
+	std::atomic<bool> m_Stopping;
+	//Keys of the positions played before the root
+	std::vector<uint64_t> m_History;
+};
\ No newline at end of file
@@ -1,13 +1,10 @@
 #pragma once
 
+#include "Core/Position.h"
 #include <string>
 #include <vector>
-#include <thread>
-#include <mutex>
-
-#define BUFFER_SIZE 8192
-//#define ENGINE_DUMP 1
 
+//Interface of the engines the boards talk to, the analysis data is guarded by GameData::EngineMutex
 class Engine
 {
 public:
@@ -17,54 +14,38 @@ public:
 	};
 	struct AnalysisData
 	{
-		std::vector<std::vector<std::string>> BestLines;
+		std::vector<std::vector<Chess::Move>> BestLines;
 		std::vector<std::vector<std::string>> BestLinesSN;
 		std::vector<std::string> Evaluations;
 		uint32_t Depth;
+		uint32_t Hashfull; //Permille of the hash table in use
 	};
 
 public:
-	Engine(const std::string& path, const std::string& name);
-	~Engine();
+	Engine(const std::string& name);
+	virtual ~Engine() = default;
+
+	virtual bool Init() = 0;
+	virtual void ResetForAnalyzing() = 0;
+	virtual void ResetForPlaying() = 0;
+	virtual void ResetForWaiting() = 0;
+	virtual void SetPosition(const std::string& fen) = 0;
+	virtual void SetPositionWithMoves(const std::string& moves) = 0;
+	virtual void SetAnalyseMode(bool value) = 0;
+	virtual void GoInfinite() = 0;
+	virtual void SearchMove(uint32_t wtime, uint32_t btime, uint32_t winc, uint32_t binc) = 0;
+	virtual void SendCommand(const std::string& command) = 0;
+	virtual void Stop() = 0;
 
-	bool Init();
-	void ResetForAnalyzing();
-	void ResetForPlaying();
-	void ResetForWaiting();
-	void SetPosition(const std::string& fen);
-	void SetPositionWithMoves(const std::string& moves);
-	void SetAnalyseMode(bool value);
-	void GoInfinite();
-	void SearchMove(uint32_t wtime, uint32_t btime, uint32_t winc, uint32_t binc);
-	void SendCommand(const std::string& command);
-	void Stop();
-	
 	std::string GetName() const;
 	const AnalysisData& GetAnalysisData() const;
-	std::string& GetBestMove();
-
-private:
-	void _Worker();
-	void _WritePipe(const std::string& message) const;
-	std::string _ReadPipe() const;
-	bool _WaitForResponse(const std::string& message, uint32_t maxms) const;
-	std::string _GetSubstringUntilChar(const std::string& str, int fromIdx, char c) const;
-	std::vector<std::string> _Split(std::string line, char c) const;
-	void _ClosePipe();
+	Chess::Move& GetBestMove();
 
-private:
+protected:
 	std::string m_Name;
-	bool m_Working;
 	Mode m_Mode;
 	bool m_WhiteToMove;
 	AnalysisData m_AnalysisData;
-	std::string m_BestMove;
-	std::thread m_Thread;
-	std::string m_Position;
-	void* m_hProcess;
-	void* m_hThread;
-	void* m_PipinW;
-	void* m_PipinR;
-	void* m_PipoutW;
-	void* m_PipoutR;
+	Chess::Move m_BestMove;
+	Chess::Position m_RootPosition;
 };
\ No newline at end of file
@@ -0,0 +1,355 @@
+#include "UCIEngine.h"
+#include "GameData/GameData.h"
+#include "Utilities/Utilities.h"
+#include <algorithm>
+#if defined(_WIN32)
+	#include <Windows.h>
+#endif
+
+#ifdef ENGINE_DUMP
+	#include <iostream>
+#endif
+
+UCIEngine::UCIEngine(const std::string& path, const std::string& name)
+	: Engine(name), m_Working(true), m_Position(""), m_hProcess(NULL), m_hThread(NULL), m_PipinW(NULL), m_PipinR(NULL), m_PipoutW(NULL), m_PipoutR(NULL)
+{
+#if defined(_WIN32)
+	SECURITY_ATTRIBUTES securityAttribs = { 0 };
+	securityAttribs.nLength = sizeof(securityAttribs);
+	securityAttribs.bInheritHandle = TRUE;
+	securityAttribs.lpSecurityDescriptor = NULL;
+
+	CreatePipe(&m_PipoutR, &m_PipoutW, &securityAttribs, 0);
+	CreatePipe(&m_PipinR, &m_PipinW, &securityAttribs, 0);
+
+	STARTUPINFOA startupInfo = { 0 };
+	startupInfo.dwFlags = STARTF_USESHOWWINDOW | STARTF_USESTDHANDLES;
+	startupInfo.wShowWindow = SW_HIDE;
+	startupInfo.hStdInput = m_PipinR;
+	startupInfo.hStdOutput = m_PipoutW;
+	startupInfo.hStdError = m_PipoutW;
+
+	PROCESS_INFORMATION processInfo = {0};
+	CreateProcessA(NULL, (LPSTR)path.c_str(), NULL, NULL, TRUE, 0, NULL, NULL, &startupInfo, &processInfo);
+	m_hProcess = processInfo.hProcess;
+	m_hThread = processInfo.hThread;
+#endif
+}
+
+UCIEngine::~UCIEngine()
+{
+	Stop();
+	_WritePipe("quit");
+	m_Working = false;
+	if (m_Thread.joinable())
+		m_Thread.join();
+	_ClosePipe();
+}
+
+bool UCIEngine::Init()
+{
+	if (m_hProcess == NULL)
+		return false;
+	_WritePipe("uci");
+	if (!_WaitForResponse("uciok", 5000))
+	{
+		_WritePipe("quit");
+		_ClosePipe();
+		return false;
+	}
+	_WritePipe("isready");
+	if (!_WaitForResponse("readyok", 5000))
+	{
+		_WritePipe("quit");
+		_ClosePipe();
+		return false;
+	}
+	_WritePipe("setoption name MultiPV value " + std::to_string(GameData::EngineLines));
+	_WritePipe("setoption name Threads value " + std::to_string(GameData::EngineThreads));
+
+	m_Thread = std::thread([this]() { this->_Worker(); });
+	return true;
+}
+
+void UCIEngine::ResetForAnalyzing()
+{
+	if (m_Mode != Mode::ANALYZE)
+	{
+		m_Mode = Mode::ANALYZE;
+		_WritePipe("ucinewgame");
+		_WritePipe("position startpos");
+		SetAnalyseMode(true);
+	}
+}
+
+void UCIEngine::ResetForPlaying()
+{
+	if (m_Mode != Mode::PLAY)
+	{
+		m_Mode = Mode::PLAY;
+		_WritePipe("ucinewgame");
+		_WritePipe("position startpos");
+		SetAnalyseMode(false);
+	}
+}
+
+void UCIEngine::ResetForWaiting()
+{
+	if (m_Mode != Mode::WAIT)
+	{
+		m_Mode = Mode::WAIT;
+		_WritePipe("stop");
+	}
+}
+
+void UCIEngine::SetPosition(const std::string& fen)
+{
+	m_AnalysisData.Depth = 0;
+	m_Position = fen;
+	m_RootPosition.SetFEN(fen);
+	m_WhiteToMove = fen.find('w') == -1 ? false : true;
+	if (m_Mode == Mode::ANALYZE)
+	{
+		_WritePipe("stop");
+		_WritePipe("position fen " + m_Position);
+		_WritePipe("go infinite");
+	}
+	else
+		_WritePipe("position fen " + m_Position);
+}
+
+void UCIEngine::SetPositionWithMoves(const std::string& moves)
+{
+	m_AnalysisData.Depth = 0;
+	m_Position = moves;
+	m_RootPosition.SetFEN(Chess::START_FEN);
+	for (const std::string& note : _Split(moves, ' '))
+	{
+		Chess::Move move = m_RootPosition.FromUCI(note);
+		if (move == Chess::Move::None())
+			break;
+		Chess::UndoInfo undo;
+		m_RootPosition.MakeMove(move, undo);
+	}
+	m_WhiteToMove = (std::count(moves.begin(), moves.end(), ' ') + 1) % 2;	
+	if (m_Mode == Mode::ANALYZE)
+	{
+		_WritePipe("stop");
+		_WritePipe("position startpos moves " + m_Position);
+		_WritePipe("go infinite");
+	}
+	else
+		_WritePipe("position startpos moves " + m_Position);
+}
+
+void UCIEngine::SetAnalyseMode(bool value)
+{
+	if (value)
+		_WritePipe("setoption name UCI_AnalyseMode value true");
+	else
+		_WritePipe("setoption name UCI_AnalyseMode value false");
+}
+
+void UCIEngine::GoInfinite()
+{
+	_WritePipe("go infinite");
+}
+
+void UCIEngine::SearchMove(uint32_t wtime, uint32_t btime, uint32_t winc, uint32_t binc)
+{
+	_WritePipe("go wtime " + std::to_string(wtime) + " btime " + std::to_string(btime) + " winc " + std::to_string(winc) + " binc " + std::to_string(binc));
+}
+
+void UCIEngine::SendCommand(const std::string& command)
+{
+	_WritePipe(command);
+}
+
+void UCIEngine::Stop()
+{
+	_WritePipe("stop");
+}
+
+void UCIEngine::_Worker()
+{
+	while (m_Working)
+	{
+		if (m_Mode != Mode::WAIT)
+		{
+			std::lock_guard<std::mutex> lock(GameData::EngineMutex);
+			std::string message = _ReadPipe();
+			std::vector<std::string> messageLines = _Split(message, '\n');
+#ifdef ENGINE_DUMP
+			if (message != "no message")
+				std::cout << message;
+#endif			
+			if (m_Mode == Mode::ANALYZE)
+			{
+				for (int i = 0; i < messageLines.size(); i++)
+				{
+					message = messageLines[i];
+					if (message.find("currmove") != -1)
+						continue;
+
+					//Read depth
+					int depthIdx = message.find("depth");
+					if (depthIdx != -1)
+						m_AnalysisData.Depth = stoi(_GetSubstringUntilChar(message, depthIdx + 6, ' '));
+
+					//Read hash usage
+					int hashfullIdx = message.find("hashfull");
+					if (hashfullIdx != -1)
+						m_AnalysisData.Hashfull = stoi(_GetSubstringUntilChar(message, hashfullIdx + 9, ' '));
+
+					//Read evaluation and line
+					int mpvIdx = message.find("multipv");
+					if (mpvIdx != -1)
+					{
+						int rank = stoi(_GetSubstringUntilChar(message, mpvIdx + 8, ' '));
+
+						//Read evaluation
+						int evalIdx = message.find("score cp");
+						if (evalIdx != -1)
+						{
+							float eval = stof(_GetSubstringUntilChar(message, evalIdx + 9, ' ')) / 100.0f * (m_WhiteToMove * 2 - 1);
+							m_AnalysisData.Evaluations[rank - 1] = (eval >= 0 ? "+" : "-") + Utils::Round(std::abs(eval), 2);
+						}
+						else
+						{
+							evalIdx = message.find("score mate");
+							float eval = stoi(_GetSubstringUntilChar(message, evalIdx + 11, ' ')) * (m_WhiteToMove * 2 - 1);
+							m_AnalysisData.Evaluations[rank - 1] = (eval >= 0 ? "+M" : "-M") + std::to_string((int)std::abs(eval));
+						}
+
+						//Read line
+						int pv = message.rfind("pv");
+						if (pv != -1)
+						{
+							std::string line = _GetSubstringUntilChar(message, pv + 3, '\r');
+							_ReadLine(_Split(line, ' '), m_AnalysisData.BestLines[rank - 1]);
+						}
+					}
+				}
+			}
+			else if (m_Mode == Mode::PLAY)
+			{
+				for (int i = 0; i < messageLines.size(); i++)
+				{
+					message = messageLines[i];
+					int bestMoveIdx = message.find("bestmove");
+					if (bestMoveIdx == -1)
+						continue;
+					std::string bestMove = _GetSubstringUntilChar(message, bestMoveIdx + 9, ' ');
+					if (bestMove == "") bestMove = _GetSubstringUntilChar(message, bestMoveIdx + 9, '\r');
+					m_BestMove = m_RootPosition.FromUCI(bestMove);
+				}
+			}
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	}
+}
+
+void UCIEngine::_ReadLine(const std::vector<std::string>& notes, std::vector<Chess::Move>& line) const
+{
+	//Play the line on a copy of the root, it ends at the first move that is not legal
+	line.clear();
+	Chess::Position position = m_RootPosition;
+	for (const std::string& note : notes)
+	{
+		Chess::Move move = position.FromUCI(note);
+		if (move == Chess::Move::None())
+			break;
+		Chess::UndoInfo undo;
+		position.MakeMove(move, undo);
+		line.push_back(move);
+	}
+}
+
+void UCIEngine::_WritePipe(const std::string& message) const
+{
+#if defined(_WIN32)
+	DWORD write;
+#ifdef ENGINE_DUMP
+	std::cout << "> " << message << std::endl;
+#endif
+	WriteFile(m_PipinW, (message + "\n").c_str(), message.size() + 1, &write, NULL);
+#endif
+}
+
+std::string UCIEngine::_ReadPipe() const
+{
+#if defined(_WIN32)
+	BYTE buffer[BUFFER_SIZE];
+	DWORD read, bytes;
+	std::string message = "";
+
+	PeekNamedPipe(m_PipoutR, buffer, sizeof(buffer), &read, &bytes, NULL);
+	if (bytes > 0)
+	{
+		do
+		{
+			ZeroMemory(buffer, sizeof(buffer));
+			if (!ReadFile(m_PipoutR, buffer, sizeof(buffer), &read, NULL) || !read) break;
+			buffer[read > BUFFER_SIZE ? BUFFER_SIZE - 1 : read] = 0;
+			message += (char*)buffer;
+		} while (read >= sizeof(buffer));
+
+		return message;
+	}
+#endif
+	return "no message";
+}
+
+bool UCIEngine::_WaitForResponse(const std::string& message, uint32_t maxms) const
+{
+	std::string response = _ReadPipe();
+	clock_t prevTime = clock();
+
+	while (response.find(message) == -1)
+	{
+		response = _ReadPipe();
+		clock_t currentTime = (clock() - prevTime) * 1000 / CLOCKS_PER_SEC;
+		if (currentTime > maxms)
+			return false;
+	}
+	return true;
+}
+
+std::string UCIEngine::_GetSubstringUntilChar(const std::string& str, int fromIdx, char c) const
+{
+	if (str.substr(fromIdx, str.size() - fromIdx).find(c) == -1) return "";
+	int endIdx = fromIdx;
+	while (str[endIdx] != c) endIdx++;
+	return str.substr(fromIdx, endIdx - fromIdx);
+}
+
+std::vector<std::string> UCIEngine::_Split(std::string line, char c) const
+{
+	std::vector<std::string> moves;
+	moves.reserve(std::count(line.begin(), line.end(), c));
+
+	size_t pos = 0, i = 0;
+	while ((pos = line.find(c)) != std::string::npos)
+	{
+		moves.emplace_back(line.substr(0, pos));
+		line.erase(0, pos + 1);
+	}
+	moves.emplace_back(line);
+
+	return moves;
+}
+
+void UCIEngine::_ClosePipe()
+{
+	//The handles are cleared, so closing twice after a failed Init is harmless
+#if defined(_WIN32)
+	if (m_PipinW != NULL) CloseHandle(m_PipinW);
+	if (m_PipinR != NULL) CloseHandle(m_PipinR);
+	if (m_PipoutW != NULL) CloseHandle(m_PipoutW);
+	if (m_PipoutR != NULL) CloseHandle(m_PipoutR);
+	if (m_hProcess != NULL) CloseHandle(m_hProcess);
+	if (m_hThread != NULL) CloseHandle(m_hThread);
+#endif
+	m_PipinW = m_PipinR = m_PipoutW = m_PipoutR = NULL;
+	m_hProcess = m_hThread = NULL;
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Engine.h"
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+
+#define BUFFER_SIZE 8192
+//#define ENGINE_DUMP 1
+
+//Engine running in its own process, it is driven through pipes with the UCI protocol
+//The pipes are only implemented on Windows, elsewhere Init fails
+class UCIEngine : public Engine
+{
+public:
+	UCIEngine(const std::string& path, const std::string& name);
+	~UCIEngine();
+
+	bool Init() override;
+	void ResetForAnalyzing() override;
+	void ResetForPlaying() override;
+	void ResetForWaiting() override;
+	void SetPosition(const std::string& fen) override;
+	void SetPositionWithMoves(const std::string& moves) override;
+	void SetAnalyseMode(bool value) override;
+	void GoInfinite() override;
+	void SearchMove(uint32_t wtime, uint32_t btime, uint32_t winc, uint32_t binc) override;
+	void SendCommand(const std::string& command) override;
+	void Stop() override;
+
+private:
+	void _Worker();
+	void _ReadLine(const std::vector<std::string>& notes, std::vector<Chess::Move>& line) const;
+	void _WritePipe(const std::string& message) const;
+	std::string _ReadPipe() const;
+	bool _WaitForResponse(const std::string& message, uint32_t maxms) const;
+	std::string _GetSubstringUntilChar(const std::string& str, int fromIdx, char c) const;
+	std::vector<std::string> _Split(std::string line, char c) const;
+	void _ClosePipe();
+
+private:
+	bool m_Working;
+	std::thread m_Thread;
+	std::string m_Position;
+	void* m_hProcess;
+	void* m_hThread;
+	void* m_PipinW;
+	void* m_PipinR;
+	void* m_PipoutW;
+	void* m_PipoutR;
+};
\ No newline at end of file
@@ -2,17 +2,22 @@
 #include "Board/AnalysisBoard.h"
 #include "Board/GameBoard.h"
 #include "Board/SetupBoard.h"
+#include "Engine/UCIEngine.h"
+#include "Engine/BuiltinEngine.h"
 #include "extras/raygui.h"
 
 Game::Game(GameState state)
 	: m_AnalysisBoard(nullptr), m_GameBoard(nullptr), m_State(GameState::MAIN_MENU)
 {
-	//Setup engines
-	GameData::Engines.push_back(new Engine("assets/stockfish14.exe", "Stockfish 14"));
-	if (GameData::Engines[0]->Init())
-		GameData::CurrentEngine = GameData::Engines[0];
+	//Setup engines, the built-in engine is always there if the UCI engine can not be started
+	Engine* stockfish = new UCIEngine("assets/stockfish14.exe", "Stockfish 14");
+	if (stockfish->Init())
+		GameData::Engines.push_back(stockfish);
 	else
-		GameData::CurrentEngine = nullptr;
+		delete stockfish;
+	GameData::Engines.push_back(new BuiltinEngine("ChessBurger"));
+	GameData::Engines.back()->Init();
+	GameData::CurrentEngine = GameData::Engines[0];
 
 	//Setup color buffer
 	GameData::Colors =
@@ -2,6 +2,8 @@
 #include "GameData.h"
 #include "Game/Game.h"
 #include "Board/IBoard.h"
+#include <algorithm>
+#include <thread>
 
 Font GameData::MainFont;
 ColorBuffer GameData::Colors;
@@ -10,6 +12,7 @@ SoundBuffer GameData::Sounds;
 std::vector<Engine*> GameData::Engines;
 Engine* GameData::CurrentEngine;
 uint32_t GameData::EngineLines = 3;
+uint32_t GameData::EngineThreads = std::max(1u, std::thread::hardware_concurrency());
 std::mutex GameData::EngineMutex;
 Color GameData::ArrowColor = DARKBLUE;
 float GameData::ArrowOpacity = 0.8f;
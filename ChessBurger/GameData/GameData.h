@@ -20,6 +20,7 @@ struct GameData
 	static std::vector<Engine*> Engines;
 	static Engine* CurrentEngine;
 	static uint32_t EngineLines;
+	static uint32_t EngineThreads;
 	static std::mutex EngineMutex;
 	static Color ArrowColor;
 	static float ArrowOpacity;
@@ -14,10 +14,10 @@ struct TextureBuffer
 };
 
 Piece::Piece(PieceType type, const Vector2& position)
-	: m_Type(type), m_Position(position), m_PreviousPosition(position), m_NextPosition(position), m_HasMoved(false), m_BoardBounds(Rectangle{ -1, -1, -1, -1 }), m_StartTime(0.0), m_CurrentTime(0.0), m_Drag(false), m_Animating(false) { }
+	: m_Type(type), m_Position(position), m_PreviousPosition(position), m_NextPosition(position), m_BoardBounds(Rectangle{ -1, -1, -1, -1 }), m_StartTime(0.0), m_CurrentTime(0.0), m_Drag(false), m_Animating(false) { }
 
 Piece::Piece()
-	: m_Type(PieceType::NONE), m_Position(Vector2{ 0, 0 }), m_PreviousPosition(Vector2{ 0, 0 }), m_NextPosition(Vector2{ 0, 0 }), m_HasMoved(false), m_BoardBounds(Rectangle{ -1, -1, -1, -1 }), m_StartTime(0.0), m_CurrentTime(0), m_Drag(false), m_Animating(false) { }
+	: m_Type(PieceType::NONE), m_Position(Vector2{ 0, 0 }), m_PreviousPosition(Vector2{ 0, 0 }), m_NextPosition(Vector2{ 0, 0 }), m_BoardBounds(Rectangle{ -1, -1, -1, -1 }), m_StartTime(0.0), m_CurrentTime(0), m_Drag(false), m_Animating(false) { }
 
 void Piece::Update()
 {
@@ -120,16 +120,6 @@ Vector2 Piece::GetPreviousPosition() const
 	return m_PreviousPosition;
 }
 
-void Piece::SetHasMoved(bool value)
-{
-	m_HasMoved = value;
-}
-
-bool Piece::GetHasMoved() const
-{
-	return m_HasMoved;
-}
-
 int8_t Piece::GetSide() const
 {
 	if (m_Type == PieceType::NONE) return -1;
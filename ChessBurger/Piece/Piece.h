@@ -35,9 +35,6 @@ public:
 	void StartAnimation(const Vector2& position);
 	void StopAnimation();
 
-	void SetHasMoved(bool value);
-	bool GetHasMoved() const;
-
 	int8_t GetSide() const;
 	void TellBoardBounds(const Rectangle& boardBounds);
 	bool OverlapPoint(const Vector2& point) const;
@@ -53,7 +50,6 @@ private:
 	Rectangle m_BoardBounds;
 	double m_StartTime;
 	double m_CurrentTime;
-	bool m_HasMoved;
 	bool m_Drag;
 	bool m_Animating;
 };
\ No newline at end of file
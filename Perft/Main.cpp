@@ -0,0 +1,579 @@
+#include "Core/Batch.h"
+#include "Core/Network.h"
+#include "Core/Notation.h"
+#include "Core/Position.h"
+#include "Core/Search.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+struct PerftCase
+{
+	const char* Name;
+	const char* FEN;
+	int Depth;
+	uint64_t Nodes;
+};
+
+//Known node counts of the standard test positions and the usual en passant, castling and promotion traps
+static const PerftCase Suite[] =
+{
+	{ "Startpos", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 6, 119060324 },
+	{ "Kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 5, 193690690 },
+	{ "Position 3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 6, 11030083 },
+	{ "Position 4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 5, 15833292 },
+	{ "Position 5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 5, 89941194 },
+	{ "Position 6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", 5, 164075551 },
+	{ "Illegal en passant 1", "8/5bk1/8/2Pp4/8/1K6/8/8 w - d6 0 1", 6, 824064 },
+	{ "Illegal en passant 2", "8/8/1k6/2b5/2pP4/8/5K2/8 b - d3 0 1", 6, 1440467 },
+	{ "En passant gives check", "8/8/1k6/8/2pP4/8/5BK1/8 b - d3 0 1", 6, 824064 },
+	{ "Horizontal en passant pin", "3k4/3p4/8/K1P4r/8/8/8/8 b - - 0 1", 6, 1134888 },
+	{ "Short castle gives check", "5k2/8/8/8/8/8/8/4K2R w K - 0 1", 6, 661072 },
+	{ "Long castle gives check", "3k4/8/8/8/8/8/8/R3K3 w Q - 0 1", 6, 803711 },
+	{ "Castling rights", "r3k2r/1b4bq/8/8/8/8/7B/R3K2R w KQkq - 0 1", 4, 1274206 },
+	{ "Castling prevented", "r3k2r/8/3Q4/8/8/5q2/8/R3K2R b KQkq - 0 1", 4, 1720476 },
+	{ "Promote out of check", "2K2r2/4P3/8/8/8/8/8/3k4 w - - 0 1", 6, 3821001 },
+	{ "Discovered check", "8/8/1P2K3/8/2n5/1q6/8/5k2 b - - 0 1", 5, 1004658 },
+	{ "Promote to give check", "4k3/1P6/8/8/8/8/K7/8 w - - 0 1", 6, 217342 },
+	{ "Underpromote to check", "8/P1k5/K7/8/8/8/8/8 w - - 0 1", 6, 92683 },
+	{ "Self stalemate", "K1k5/8/P7/8/8/8/8/8 w - - 0 1", 6, 2217 },
+	{ "Stalemate and checkmate 1", "8/k1P5/8/1K6/8/8/8/8 w - - 0 1", 7, 567584 },
+	{ "Stalemate and checkmate 2", "8/8/2k5/5q2/5n2/8/5K2/8 b - - 0 1", 4, 23527 }
+};
+
+static uint64_t _Perft(Chess::Position& position, int depth)
+{
+	Chess::MoveList moves;
+	position.GenerateLegalMoves(moves);
+
+	//Bulk counting, the leaves are not made
+	if (depth <= 1)
+		return depth == 1 ? moves.GetSize() : 1;
+
+	uint64_t nodes = 0;
+	Chess::UndoInfo undo;
+	for (const Chess::Move& move : moves)
+	{
+		position.MakeMove(move, undo);
+		nodes += _Perft(position, depth - 1);
+		position.UnmakeMove(move, undo);
+	}
+	return nodes;
+}
+
+static uint64_t _Divide(Chess::Position& position, int depth)
+{
+	Chess::MoveList moves;
+	position.GenerateLegalMoves(moves);
+
+	uint64_t nodes = 0;
+	Chess::UndoInfo undo;
+	for (const Chess::Move& move : moves)
+	{
+		position.MakeMove(move, undo);
+		uint64_t count = _Perft(position, depth - 1);
+		position.UnmakeMove(move, undo);
+		printf("%s: %llu\n", Chess::ToUCI(move).c_str(), (unsigned long long)count);
+		nodes += count;
+	}
+	printf("\n");
+	return nodes;
+}
+
+static double _Seconds(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool _RunSuite()
+{
+	uint64_t totalNodes = 0;
+	double totalSeconds = 0.0;
+	int failed = 0;
+	for (const PerftCase& test : Suite)
+	{
+		Chess::Position position;
+		position.SetFEN(test.FEN);
+
+		auto start = std::chrono::steady_clock::now();
+		uint64_t nodes = _Perft(position, test.Depth);
+		double seconds = _Seconds(start);
+		totalNodes += nodes;
+		totalSeconds += seconds;
+
+		bool passed = nodes == test.Nodes;
+		if (!passed)
+			failed++;
+		printf("%-4s %-28s depth %d %12llu nodes %8.3f s %8.2f Mnps\n", passed ? "OK" : "FAIL", test.Name, test.Depth, (unsigned long long)nodes, seconds, nodes / seconds / 1e6);
+		if (!passed)
+			printf("     expected %llu nodes\n", (unsigned long long)test.Nodes);
+	}
+	printf("\n%d/%d passed, %llu nodes in %.3f s, %.2f Mnps\n", (int)(sizeof(Suite) / sizeof(Suite[0])) - failed, (int)(sizeof(Suite) / sizeof(Suite[0])),
+		(unsigned long long)totalNodes, totalSeconds, totalNodes / totalSeconds / 1e6);
+	return failed == 0;
+}
+
+//Parses and writes every FEN or EPD line of the file over and over, the suite positions are used without a file
+static bool _BenchmarkFEN(const char* path)
+{
+	std::string text;
+	if (path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file)
+		{
+			printf("Can not open %s\n", path);
+			return false;
+		}
+		std::stringstream stream;
+		stream << file.rdbuf();
+		text = stream.str();
+	}
+	else
+	{
+		for (const PerftCase& test : Suite)
+			text += std::string(test.FEN) + "\n";
+	}
+
+	std::vector<std::string_view> lines;
+	for (size_t begin = 0; begin < text.size();)
+	{
+		size_t end = text.find('\n', begin);
+		if (end == std::string::npos)
+			end = text.size();
+		if (end > begin)
+			lines.emplace_back(text.data() + begin, end - begin);
+		begin = end + 1;
+	}
+
+	//The written FEN has to describe the same position as the line
+	Chess::Position position, written;
+	char buffer[Chess::MAX_FEN_LENGTH];
+	int invalid = 0, mismatched = 0;
+	for (std::string_view line : lines)
+	{
+		if (!position.SetFEN(line) && !position.SetEPD(line))
+			invalid++;
+		else
+		{
+			position.WriteFEN(buffer);
+			if (!written.SetFEN(buffer) || written.GetKey() != position.GetKey())
+				mismatched++;
+		}
+	}
+	if (lines.empty() || invalid == (int)lines.size())
+	{
+		printf("No valid positions\n");
+		return false;
+	}
+
+	//Round trip at least two million positions
+	int rounds = (int)(2000000 / lines.size()) + 1;
+	uint64_t count = 0, checksum = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (int round = 0; round < rounds; round++)
+	{
+		for (std::string_view line : lines)
+		{
+			if (position.SetFEN(line) || position.SetEPD(line))
+			{
+				checksum += position.WriteFEN(buffer);
+				count++;
+			}
+		}
+	}
+	double seconds = _Seconds(start);
+	printf("Positions: %zu (%d invalid, %d mismatched)\n", lines.size(), invalid, mismatched);
+	printf("Round trips: %llu in %.3f s, %.2f M/s (checksum %llu)\n", (unsigned long long)count, seconds, count / seconds / 1e6, (unsigned long long)checksum);
+	return mismatched == 0;
+}
+
+struct SANCase
+{
+	int Position;
+	Chess::Move Move;
+	char SAN[Chess::MAX_SAN_LENGTH];
+};
+
+//Writes every legal move of the positions up to the depth
+static void _CollectSAN(Chess::Position& position, int depth, std::vector<Chess::Position>& positions, std::vector<SANCase>& cases)
+{
+	Chess::MoveList moves;
+	position.GenerateLegalMoves(moves);
+	positions.push_back(position);
+	for (const Chess::Move& move : moves)
+	{
+		SANCase test = { (int)positions.size() - 1, move, {} };
+		Chess::WriteSAN(position, move, test.SAN);
+		cases.push_back(test);
+	}
+
+	if (depth > 1)
+	{
+		for (const Chess::Move& move : moves)
+		{
+			Chess::UndoInfo undo;
+			position.MakeMove(move, undo);
+			_CollectSAN(position, depth - 1, positions, cases);
+			position.UnmakeMove(move, undo);
+		}
+	}
+}
+
+static bool _BenchmarkSAN()
+{
+	std::vector<Chess::Position> positions;
+	std::vector<SANCase> cases;
+	for (const PerftCase& test : Suite)
+	{
+		Chess::Position position;
+		position.SetFEN(test.FEN);
+		_CollectSAN(position, 2, positions, cases);
+	}
+
+	//Parse at least five million moves, every one has to give back the written move
+	int rounds = (int)(5000000 / cases.size()) + 1;
+	uint64_t count = 0, mismatched = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (int round = 0; round < rounds; round++)
+	{
+		for (const SANCase& test : cases)
+		{
+			if (Chess::FromSAN(positions[test.Position], test.SAN) != test.Move)
+				mismatched++;
+			count++;
+		}
+	}
+	double seconds = _Seconds(start);
+	printf("Moves: %zu in %zu positions (%llu mismatched)\n", cases.size(), positions.size(), (unsigned long long)(mismatched / rounds));
+	printf("Parsed: %llu in %.3f s, %.2f M/s\n", (unsigned long long)count, seconds, count / seconds / 1e6);
+	return mismatched == 0;
+}
+
+struct ExchangeCase
+{
+	const char* Name;
+	const char* FEN;
+	const char* Move;
+	int Value;
+};
+
+//Exchanges with a known result, the cases around pins and kings are easy to get wrong
+static const ExchangeCase Exchanges[] =
+{
+	{ "Defended pawn", "4k3/8/2n5/4p3/8/8/8/K3R3 w - - 0 1", "e1e5", -400 },
+	{ "Pinned defender", "4k3/8/2n5/1B2p3/8/8/8/K3R3 w - - 0 1", "e1e5", 100 },
+	{ "Pinned along the line", "4k3/4r3/8/4n3/3B4/8/8/K3R3 w - - 0 1", "d4e5", 300 },
+	{ "King recaptures", "8/8/4k3/4p3/2N5/8/8/6K1 w - - 0 1", "c4e5", -200 },
+	{ "King defends against king", "8/8/4k3/4p3/2N2K2/8/8/8 w - - 0 1", "c4e5", 100 }
+};
+
+static bool _BenchmarkSEE()
+{
+	bool passed = true;
+	for (const ExchangeCase& test : Exchanges)
+	{
+		Chess::Position position;
+		position.SetFEN(test.FEN);
+		int value = position.StaticExchange(position.FromUCI(test.Move));
+		if (value != test.Value)
+		{
+			printf("%-26s %s %d, expected %d\n", test.Name, test.Move, value, test.Value);
+			passed = false;
+		}
+	}
+
+	std::vector<Chess::Position> positions;
+	std::vector<SANCase> cases;
+	for (const PerftCase& test : Suite)
+	{
+		Chess::Position position;
+		position.SetFEN(test.FEN);
+		_CollectSAN(position, 2, positions, cases);
+	}
+
+	//Exchange every capture at least ten million times
+	std::vector<SANCase> captures;
+	for (const SANCase& test : cases)
+		if (positions[test.Position].IsCapture(test.Move))
+			captures.push_back(test);
+	int rounds = (int)(10000000 / captures.size()) + 1;
+	int64_t checksum = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (int round = 0; round < rounds; round++)
+		for (const SANCase& test : captures)
+			checksum += positions[test.Position].StaticExchange(test.Move);
+	double seconds = _Seconds(start);
+	uint64_t count = (uint64_t)rounds * captures.size();
+	printf("Captures: %zu in %zu positions\n", captures.size(), positions.size());
+	printf("Exchanges: %llu in %.3f s, %.1f ns each (checksum %lld)\n", (unsigned long long)count, seconds, seconds * 1e9 / count, (long long)checksum);
+	return passed;
+}
+
+//More legal moves than MAX_MOVES, which is the most a game can reach
+static const char CrowdedFEN[] = "knQ4Q/nn2Q3/1Q4Q1/3Q4/Q4Q1Q/Q1Q4Q/4Q3/1Q4QK w - - 0 1";
+
+static bool _BenchmarkBatch(int threads)
+{
+	//The positions around the suite, repeated to fill the array
+	std::vector<Chess::Position> around;
+	std::vector<SANCase> cases;
+	for (const PerftCase& test : Suite)
+	{
+		Chess::Position position;
+		position.SetFEN(test.FEN);
+		_CollectSAN(position, 2, around, cases);
+	}
+	std::vector<Chess::Position> positions(1 << 17);
+	for (size_t i = 0; i < positions.size(); i++)
+		positions[i] = around[i % around.size()];
+
+	//A FEN may set up more moves than a game reaches, it goes last so that a slot too small would overrun the array
+	Chess::Position& crowded = positions.back();
+	crowded.SetFEN(CrowdedFEN);
+	Chess::MoveList crowdedMoves;
+	crowded.GenerateLegalMoves(crowdedMoves);
+
+	//One spare slot behind the array has to stay empty
+	std::vector<Chess::PositionInfo> infos(positions.size());
+	std::vector<Chess::Move> moves((positions.size() + 1) * Chess::MoveList::CAPACITY, Chess::Move::None());
+	const Chess::Move* spare = moves.data() + positions.size() * Chess::MoveList::CAPACITY;
+	uint64_t reference = 0;
+	for (int count : { 1, threads > 0 ? threads : (int)std::max(1u, std::thread::hardware_concurrency()) })
+	{
+		const int rounds = 20;
+		auto start = std::chrono::steady_clock::now();
+		for (int round = 0; round < rounds; round++)
+			Chess::AnalysePositions(positions.data(), positions.size(), infos.data(), moves.data(), count);
+		double seconds = _Seconds(start);
+
+		//Every thread count has to give the same moves
+		uint64_t checksum = 0;
+		for (size_t i = 0; i < infos.size(); i++)
+			checksum = checksum * 31 + infos[i].MoveCount + infos[i].Status + moves[i * Chess::MoveList::CAPACITY].GetFrom();
+		if (count == 1)
+			reference = checksum;
+		printf("Threads: %-3d %.2f M positions/s (checksum %llu)\n", count, positions.size() * rounds / seconds / 1e6, (unsigned long long)checksum);
+		if (checksum != reference)
+			return false;
+
+		const Chess::Move* last = spare - Chess::MoveList::CAPACITY;
+		if (infos.back().MoveCount != crowdedMoves.GetSize() || !std::equal(crowdedMoves.begin(), crowdedMoves.end(), last)
+			|| std::any_of(spare, spare + Chess::MoveList::CAPACITY, [](const Chess::Move& move) { return move != Chess::Move::None(); }))
+		{
+			printf("The %d moves of the crowded position were not written to its slot\n", crowdedMoves.GetSize());
+			return false;
+		}
+	}
+	return true;
+}
+
+//Values spread evenly between the bounds, written like the network files store them
+template<typename T>
+static void _WriteRandom(std::ostream& stream, std::mt19937& random, size_t count, int low, int high)
+{
+	std::uniform_int_distribution<int> distribution(low, high);
+	std::vector<T> values(count);
+	for (T& value : values)
+		value = (T)distribution(random);
+	stream.write((const char*)values.data(), sizeof(T) * count);
+}
+
+//Network file with random weights, small enough that most of the first layer sums stay inside the clipped range
+static std::string _RandomNetwork(uint32_t seed)
+{
+	std::mt19937 random(seed);
+	std::ostringstream stream(std::ios::binary);
+	const char description[] = "Random weights";
+	uint32_t header[] = { Chess::NETWORK_VERSION, 0, sizeof(description) - 1 };
+	stream.write((const char*)header, sizeof(header));
+	stream.write(description, sizeof(description) - 1);
+	_WriteRandom<uint32_t>(stream, random, 1, 0, 0);
+	_WriteRandom<int16_t>(stream, random, Chess::NETWORK_HALF, 0, 64);
+	_WriteRandom<int16_t>(stream, random, (size_t)Chess::NETWORK_INPUTS * Chess::NETWORK_HALF, -8, 8);
+	_WriteRandom<uint32_t>(stream, random, 1, 0, 0);
+	_WriteRandom<int32_t>(stream, random, Chess::NETWORK_HIDDEN, -4000, 4000);
+	_WriteRandom<int8_t>(stream, random, Chess::NETWORK_HIDDEN * 2 * Chess::NETWORK_HALF, -32, 32);
+	_WriteRandom<int32_t>(stream, random, Chess::NETWORK_HIDDEN, -4000, 4000);
+	_WriteRandom<int8_t>(stream, random, Chess::NETWORK_HIDDEN * Chess::NETWORK_HIDDEN, -32, 32);
+	_WriteRandom<int32_t>(stream, random, 1, -4000, 4000);
+	_WriteRandom<int8_t>(stream, random, Chess::NETWORK_HIDDEN, -64, 64);
+	return stream.str();
+}
+
+//Plays random games from the suite positions and compares the updated accumulators with refreshed ones after every move,
+//then every kernel the processor supports has to give the same evaluations
+static bool _CheckNetwork(int games)
+{
+	std::istringstream stream(_RandomNetwork(1));
+	Chess::Network network;
+	if (!network.Load(stream))
+	{
+		printf("Could not load the random network\n");
+		return false;
+	}
+
+	bool passed = true;
+	uint64_t reference = 0;
+	for (const std::string& kernels : Chess::Network::GetSupportedKernels())
+	{
+		Chess::Network::SelectKernels(kernels);
+		std::mt19937 random(7);
+		uint64_t checksum = 0, updates = 0, mismatched = 0;
+		int captures = 0, castles = 0, enPassants = 0, promotions = 0, kingMoves = 0;
+		for (const PerftCase& test : Suite)
+		{
+			for (int game = 0; game < games; game++)
+			{
+				Chess::Position position;
+				position.SetFEN(test.FEN);
+				Chess::Accumulator accumulators[2], refreshed;
+				network.Refresh(position, accumulators[0]);
+				for (int ply = 0; ply < 40; ply++)
+				{
+					Chess::MoveList moves;
+					position.GenerateLegalMoves(moves);
+					if (moves.IsEmpty())
+						break;
+
+					//Half of the moves are captures, castles, en passant and promotions if there are any, they are the ones an update gets wrong
+					Chess::MoveList special;
+					for (const Chess::Move& move : moves)
+						if (move.GetType() != Chess::MOVE_NORMAL || position.IsCapture(move))
+							special.Add(move);
+					const Chess::MoveList& pick = !special.IsEmpty() && random() % 2 ? special : moves;
+					Chess::Move move = pick[random() % pick.GetSize()];
+
+					captures += position.IsCapture(move);
+					castles += move.GetType() == Chess::MOVE_CASTLING;
+					enPassants += move.GetType() == Chess::MOVE_EN_PASSANT;
+					promotions += move.GetType() == Chess::MOVE_PROMOTION;
+					kingMoves += position.GetKindOn(move.GetFrom()) == Chess::KING;
+
+					Chess::UndoInfo undo;
+					position.MakeMove(move, undo);
+					Chess::Accumulator& child = accumulators[(ply + 1) & 1];
+					network.Update(accumulators[ply & 1], child, position, move, undo);
+					network.Refresh(position, refreshed);
+					mismatched += memcmp(&child, &refreshed, sizeof(child)) != 0;
+					checksum = checksum * 31 + (uint32_t)network.Evaluate(child, position.GetSideToMove());
+					updates++;
+				}
+			}
+		}
+
+		if (reference == 0)
+			reference = checksum;
+		printf("%-7s %llu updates (%llu mismatched), %d captures, %d castles, %d en passant, %d promotions, %d king moves (checksum %llu)\n",
+			kernels.c_str(), (unsigned long long)updates, (unsigned long long)mismatched, captures, castles, enPassants, promotions, kingMoves, (unsigned long long)checksum);
+		passed = passed && mismatched == 0 && checksum == reference;
+	}
+	Chess::Network::SelectKernels(Chess::Network::GetSupportedKernels()[0]);
+	return passed;
+}
+
+static bool _BenchmarkSearch(int depth, int threads, const char* networkPath)
+{
+	//The hand written evaluation is used without a network
+	Chess::Network network;
+	if (networkPath)
+	{
+		if (!network.Load(networkPath))
+		{
+			printf("Could not load the network %s\n", networkPath);
+			return false;
+		}
+		printf("Network %s with the %s kernels\n", networkPath, Chess::Network::GetKernelName());
+	}
+
+	//The six standard positions, the rest of the suite are endgames that are solved at once
+	Chess::TranspositionTable table;
+	uint64_t nodes = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < 6; i++)
+	{
+		Chess::Position position;
+		position.SetFEN(Suite[i].FEN);
+		Chess::SearchLimits limits;
+		limits.Depth = depth;
+		Chess::SearchReport last = {};
+		Chess::Search search(table, threads);
+		search.SetNetwork(networkPath ? &network : nullptr);
+		Chess::Move move = search.Run(position, {}, limits, [&last](const Chess::SearchReport& report) { last = report; });
+		nodes += last.Nodes;
+		printf("%-12s %-6s score %6d nodes %12llu hashfull %4d\n", Suite[i].Name, Chess::ToSAN(position, move).c_str(), last.Lines[0].Score, (unsigned long long)last.Nodes, last.Hashfull);
+		table.Clear();
+	}
+	double seconds = _Seconds(start);
+	printf("Searched %llu nodes on %d threads in %.3f s, %.2f Mnps\n", (unsigned long long)nodes, threads, seconds, nodes / seconds / 1e6);
+	return true;
+}
+
+static void _PrintUsage()
+{
+	printf("Usage: Perft                           run the built-in suite\n");
+	printf("       Perft <depth> [fen] [--divide]  count the leaf nodes of the position\n");
+	printf("       Perft --fen [file]              round trip the FEN or EPD lines of the file\n");
+	printf("       Perft --san                     parse the SAN of the moves around the suite positions\n");
+	printf("       Perft --batch [threads]         analyse an array of positions on one and on all threads\n");
+	printf("       Perft --see                     check the known exchanges and time the captures around the suite positions\n");
+	printf("       Perft --search [depth] [threads] [network] search the standard positions to the depth\n");
+	printf("       Perft --network [games]         check the network updates on random games with every kernel\n");
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+		return _RunSuite() ? 0 : 1;
+	if (strcmp(argv[1], "--fen") == 0)
+		return _BenchmarkFEN(argc > 2 ? argv[2] : nullptr) ? 0 : 1;
+	if (strcmp(argv[1], "--san") == 0)
+		return _BenchmarkSAN() ? 0 : 1;
+	if (strcmp(argv[1], "--batch") == 0)
+		return _BenchmarkBatch(argc > 2 ? atoi(argv[2]) : 0) ? 0 : 1;
+	if (strcmp(argv[1], "--see") == 0)
+		return _BenchmarkSEE() ? 0 : 1;
+	if (strcmp(argv[1], "--network") == 0)
+		return _CheckNetwork(argc > 2 ? atoi(argv[2]) : 64) ? 0 : 1;
+	if (strcmp(argv[1], "--search") == 0)
+		return _BenchmarkSearch(argc > 2 ? atoi(argv[2]) : 8, argc > 3 ? atoi(argv[3]) : 1, argc > 4 ? argv[4] : nullptr) ? 0 : 1;
+
+	int depth = atoi(argv[1]);
+	if (depth < 1)
+	{
+		_PrintUsage();
+		return 1;
+	}
+
+	//The FEN may be passed as one argument or split into its fields
+	std::string fen;
+	bool divide = false;
+	for (int i = 2; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--divide") == 0)
+			divide = true;
+		else
+			fen += (fen.empty() ? "" : " ") + std::string(argv[i]);
+	}
+
+	Chess::Position position;
+	if (!position.SetFEN(fen.empty() ? Chess::START_FEN : fen))
+	{
+		printf("Invalid FEN: %s\n", fen.c_str());
+		return 1;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	uint64_t nodes = divide ? _Divide(position, depth) : _Perft(position, depth);
+	double seconds = _Seconds(start);
+	printf("Nodes: %llu\nTime: %.3f s\nSpeed: %.2f Mnps\n", (unsigned long long)nodes, seconds, nodes / seconds / 1e6);
+	return 0;
+}
\ No newline at end of file
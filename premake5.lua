@@ -55,6 +55,26 @@ project "raylib"
 		}
 		files {"raylib/src/*.h", "raylib/src/*.c"}
 		
+project "ChessCore"
+	kind "StaticLib"
+	location "build"
+	language "C++"
+	targetdir "bin/%{cfg.buildcfg}"
+	cppdialect "C++17"
+	
+	vpaths 
+	{
+		["Header Files"] = { "**.h"},
+		["Source Files"] = {"**.cpp"},
+	}
+	files {"%{wks.name}/Core/**.cpp", "%{wks.name}/Core/**.h"}
+	
+	includedirs { "%{wks.name}" }
+	
+	filter "action:vs*"
+		defines{"_CRT_SECURE_NO_WARNINGS"}
+		buildoptions {"/constexpr:steps10000000"}
+		
 project "ChessBurger"
 	kind "ConsoleApp"
 	location "%{wks.name}"
@@ -69,17 +89,44 @@ project "ChessBurger"
 		["Source Files"] = {"**.c", "**.cpp"},
 	}
 	files {"%{wks.name}/**.c", "%{wks.name}/**.cpp", "%{wks.name}/**.h"}
+	removefiles {"%{wks.name}/Core/**"}
 
-	links {"raylib"}
+	links {"raylib", "ChessCore"}
 	
 	includedirs { "%{wks.name}", "raylib/src" }
 	defines{"PLATFORM_DESKTOP", "GRAPHICS_API_OPENGL_33"}
 	
 	filter "action:vs*"
 		defines{"_WINSOCK_DEPRECATED_NO_WARNINGS", "_CRT_SECURE_NO_WARNINGS", "_WIN32"}
-		dependson {"raylib"}
-		links {"raylib.lib", "winmm", "kernel32"}
+		dependson {"raylib", "ChessCore"}
+		links {"raylib.lib", "ChessCore.lib", "winmm", "kernel32"}
 		libdirs {"bin/%{cfg.buildcfg}"}
+		buildoptions {"/constexpr:steps10000000"}
+		
+	filter "action:gmake*"
+		links {"pthread", "GL", "m", "dl", "rt", "X11"}
+		
+project "Perft"
+	kind "ConsoleApp"
+	location "%{prj.name}"
+	language "C++"
+	targetdir "bin/%{cfg.buildcfg}"
+	cppdialect "C++17"
+	
+	vpaths 
+	{
+		["Header Files"] = { "**.h"},
+		["Source Files"] = {"**.c", "**.cpp"},
+	}
+	files {"%{prj.name}/**.cpp", "%{prj.name}/**.h"}
+	
+	includedirs { "%{wks.name}" }
+	links {"ChessCore"}
+	
+	filter "action:vs*"
+		defines{"_CRT_SECURE_NO_WARNINGS"}
+		buildoptions {"/constexpr:steps10000000"}
+		dependson {"ChessCore"}
 		
 	filter "action:gmake*"
-		links {"pthread", "GL", "m", "dl", "rt", "X11"}
\ No newline at end of file
+		links {"pthread"}
\ No newline at end of file